@@ -0,0 +1,158 @@
+// Acq.cpp — Acquisition des joysticks filaires : ADS1115 (I2C) ou CAN SPI type MCP3208
+#include "Acq.h"
+#include "IOMap.h"
+#include "Hal.h"
+#include "I2cSched.h"
+
+// Suréchantillonnage : ADS_OVERSAMPLE conversions sommées puis décimées (moyenne par décalage)
+constexpr uint8_t oversampleShift(){ uint8_t s=0; while((1u<<s) < ADS_OVERSAMPLE) s++; return s; }
+static_assert(ADS_OVERSAMPLE>=1 && ADS_OVERSAMPLE<=16 && (1u<<oversampleShift())==ADS_OVERSAMPLE,
+              "ADS_OVERSAMPLE doit valoir 1, 2, 4, 8 ou 16");
+
+#if ACQ_BACKEND == ACQ_ADS1115
+// ---------------- ADS1115 : entrées AXES[].ads / .ch ----------------
+static_assert(ADS_DATA_RATE_SPS==8 || ADS_DATA_RATE_SPS==16 || ADS_DATA_RATE_SPS==32 || ADS_DATA_RATE_SPS==64 || ADS_DATA_RATE_SPS==128
+              || ADS_DATA_RATE_SPS==250 || ADS_DATA_RATE_SPS==475 || ADS_DATA_RATE_SPS==860, "ADS_DATA_RATE_SPS : débit ADS1115 inconnu");
+
+// Pas de sondage du registre de configuration avant la durée nominale de conversion,
+// puis un sondage par ADS_POLL_US (l'horloge interne de l'ADS varie de ±10 %).
+static constexpr uint32_t ADS_CONV_NOMINAL_US = 1000000UL / ADS_DATA_RATE_SPS;
+static constexpr uint32_t ADS_POLL_US = (ADS_CONV_NOMINAL_US/8 > 100)? ADS_CONV_NOMINAL_US/8 : 100;
+// Au-delà de deux conversions nominales (+ 2 ms de bus), l'axe est lu neutre (le watchdog I2C signalera la carte)
+static constexpr uint32_t ADS_CONV_TIMEOUT_US = 2*ADS_CONV_NOMINAL_US + 2000;
+// Le scan bloque la boucle : AXES_SCAN_ROUNDS × ADS_OVERSAMPLE conversions successives
+static constexpr uint32_t ADS_SCAN_WORST_MS = (uint32_t)AXES_SCAN_ROUNDS * ADS_OVERSAMPLE * ADS_CONV_NOMINAL_US / 1000;
+static_assert(ADS_SCAN_WORST_MS <= ADS_SCAN_MAX_MS,
+              "ADS_DATA_RATE_SPS / ADS_OVERSAMPLE : scan plus long que ADS_SCAN_MAX_MS (boucle bloquée)");
+static uint32_t adsStartUs[HAL_ADS_COUNT];   // lancement de la conversion en cours, par carte
+
+static inline void startConv(uint8_t ads, uint8_t ch){ halAdsStart(ads, ch); adsStartUs[ads] = halMicros(); }
+static inline bool convDue(uint8_t ads){ return halMicros() - adsStartUs[ads] >= ADS_CONV_NOMINAL_US; }
+
+template<uint8_t I>
+static inline int16_t readAxisResult(){
+  constexpr AxisWiring w = AXES[I];
+  int16_t v=16384;
+  if(adsOK[w.ads]){
+    uint32_t el = halMicros() - adsStartUs[w.ads];
+    if(el < ADS_CONV_NOMINAL_US) halDelayUs(ADS_CONV_NOMINAL_US - el);
+    bool ok=true;
+    while(!halAdsReady(w.ads)){
+      if(halMicros() - adsStartUs[w.ads] > ADS_CONV_TIMEOUT_US){ ok=false; break; }
+      halDelayUs(ADS_POLL_US);
+    }
+    if(ok) v=halAdsResult(w.ads);
+  }
+  return v;
+}
+
+// Un tour : lance la conversion de l'axe R de chaque carte, puis les relit
+template<uint8_t R>
+static inline void scanRound(ADSRaw& r){
+  int32_t acc[AX_COUNT];
+  for(uint8_t k=0;k<ADS_OVERSAMPLE;k++){
+    axesForEach([&](auto ax){
+      constexpr uint8_t i = decltype(ax)::value;
+      if constexpr (axesScanRound(i)==R){ if(adsOK[AXES[i].ads]) startConv(AXES[i].ads, AXES[i].ch); }
+    });
+    axesForEach([&](auto ax){
+      constexpr uint8_t i = decltype(ax)::value;
+      if constexpr (axesScanRound(i)==R){ int16_t v=readAxisResult<i>(); acc[i] = k? acc[i]+v : v; }
+    });
+  }
+  axesForEach([&](auto ax){
+    constexpr uint8_t i = decltype(ax)::value;
+    if constexpr (axesScanRound(i)==R){ r.v[i]=(int16_t)(acc[i] >> oversampleShift()); r.tAcqUs[i]=halMicros(); }
+  });
+}
+template<size_t... R>
+static inline void scanAll(ADSRaw& r, std::index_sequence<R...>){ (scanRound<(uint8_t)R>(r), ...); }
+
+bool acqBegin(){
+  for(uint8_t b=0;b<AXES_ADS_USED;b++) adsOK[b] = halI2CProbe(HAL_I2C_ADS, HAL_ADS_ADDR(b)) && halAdsBegin(b, HAL_ADS_ADDR(b));
+  return acqAllOK();
+}
+// AXES_SCAN_ROUNDS tours (≤ 4) quel que soit le nombre de cartes ADS
+static uint32_t scanGen = 0;   // change à chaque scan de contrôle (multiplexeurs ADS reprogrammés)
+void acqScan(ADSRaw& r){
+  i2cBegin(I2C_SAMPLE);
+  scanAll(r, std::make_index_sequence<AXES_SCAN_ROUNDS>{});
+  scanGen++;
+  i2cEnd();
+}
+
+// Diagnostic : un axe par appel, conversion lancée à un passage et relue au suivant.
+// Un scan de contrôle intercalé reprogramme le multiplexeur : l'axe est relancé.
+static int8_t diagAxis = -1;
+static uint32_t diagGen = 0;
+bool acqDiagStep(ADSRaw& r){
+  if(diagAxis < 0) diagAxis = 0;
+  else if(!adsOK[AXES[diagAxis].ads]){ r.v[diagAxis]=16384; r.tAcqUs[diagAxis]=halMicros(); diagAxis++; }
+  else if(diagGen == scanGen){
+    if(!convDue(AXES[diagAxis].ads) || !halAdsReady(AXES[diagAxis].ads)) return false;
+    r.v[diagAxis]=halAdsResult(AXES[diagAxis].ads); r.tAcqUs[diagAxis]=halMicros(); diagAxis++;
+  }
+  while(diagAxis < AX_COUNT && !adsOK[AXES[diagAxis].ads]){ r.v[diagAxis]=16384; r.tAcqUs[diagAxis]=halMicros(); diagAxis++; }
+  if(diagAxis >= AX_COUNT){ diagAxis = -1; return true; }
+  startConv(AXES[diagAxis].ads, AXES[diagAxis].ch);
+  diagGen = scanGen;
+  return false;
+}
+bool acqAxisOK(uint8_t axis){ return axis<AX_COUNT && adsOK[AXES[axis].ads]; }
+bool acqAllOK(){
+  for(uint8_t b=0;b<AXES_ADS_USED;b++) if(!adsOK[b]) return false;
+  return true;
+}
+bool acqProbe(){
+  for(uint8_t b=0;b<AXES_ADS_USED;b++) adsOK[b]=halI2CProbe(HAL_I2C_ADS, HAL_ADS_ADDR(b));
+  return acqAllOK();
+}
+const char* acqBackendName(){ return "ADS1115"; }
+
+#elif ACQ_BACKEND == ACQ_SPI_ADC
+// ---------------- CAN SPI 8 voies 12 bits (MCP3208) ----------------
+// Commande : START|SGL|D2, D1 D0 << 6, 0 ; réponse : bit nul (rx[1] bit 4) puis B11..B0.
+// Bit nul à 1 = pas de CAN sur le bus (MISO tiré haut) : l'axe est lu neutre.
+static_assert(AX_COUNT <= HAL_SPI_FRAME_MAX, "Acq SPI : une trame par scan");
+
+static bool spiBusOK = false, spiOK = false;
+static uint8_t txFrame[AX_COUNT][3];
+
+static inline void encode(uint8_t out[3], uint8_t ch){ out[0]=0x06 | (ch>>2); out[1]=(uint8_t)(ch<<6); out[2]=0; }
+static inline bool valid(const uint8_t in[3]){ return !(in[1] & 0x10); }
+static inline int16_t decode(const uint8_t in[3]){ return (int16_t)((((in[1] & 0x0F) << 8) | in[2]) << 3); }   // 12 → 15 bits
+
+bool acqBegin(){
+  for(uint8_t i=0;i<AX_COUNT;i++) encode(txFrame[i], ACQ_SPI_CH[i]);
+  spiBusOK = halSpiAdcBegin();
+  return acqProbe();
+}
+
+void acqScan(ADSRaw& r){
+  int32_t acc[AX_COUNT] = {};
+  uint8_t rx[AX_COUNT][3];
+  for(uint8_t k=0;k<ADS_OVERSAMPLE && spiOK;k++){
+    if(!halSpiAdcFrame(txFrame, rx, AX_COUNT)){ spiOK = false; break; }
+    for(uint8_t i=0;i<AX_COUNT;i++){
+      if(!valid(rx[i])){ spiOK = false; break; }
+      acc[i] += decode(rx[i]);
+    }
+  }
+  uint32_t t = halMicros();
+  for(uint8_t i=0;i<AX_COUNT;i++){ r.v[i] = spiOK? (int16_t)(acc[i] >> oversampleShift()) : 16384; r.tAcqUs[i] = t; }
+}
+
+bool acqDiagStep(ADSRaw& r){ acqScan(r); return true; }   // trame courte : pas de découpage
+bool acqAxisOK(uint8_t axis){ return axis<AX_COUNT && spiOK; }
+bool acqAllOK(){ return spiOK; }
+bool acqProbe(){
+  if(!spiBusOK) spiBusOK = halSpiAdcBegin();
+  uint8_t rx[1][3];
+  spiOK = spiBusOK && halSpiAdcFrame(txFrame, rx, 1) && valid(rx[0]);
+  return spiOK;
+}
+const char* acqBackendName(){ return "CAN SPI"; }
+
+#else
+#error "ACQ_BACKEND : ACQ_ADS1115 ou ACQ_SPI_ADC"
+#endif
@@ -0,0 +1,20 @@
+// Acq.h — Acquisition des joysticks filaires : ADS1115 (I2C) ou CAN SPI type MCP3208
+#pragma once
+#include "Config.h"
+#include "Axes.h"
+
+struct ADSRaw;
+
+// readADSRaw() (IOMap) ne lit que par ici ; inversion, bruit et mapping restent communs.
+//   - ACQ_ADS1115 : AXES_SCAN_ROUNDS tours, conversions des cartes en parallèle (état adsOK[])
+//   - ACQ_SPI_ADC : une trame DMA de AX_COUNT transactions par suréchantillon, hors bus I2C
+// Mesures brutes non inversées, échelle 0..32767 quel que soit le CAN ; axe absent = 16384.
+// Choix à la compilation : ACQ_BACKEND (Config.h).
+
+bool acqBegin();                 // cartes ADS (sondées) ou bus SPI
+void acqScan(ADSRaw& r);
+bool acqDiagStep(ADSRaw& r);     // lecture de diagnostic sans attente ; true = r complet
+bool acqAxisOK(uint8_t axis);    // convertisseur porteur présent
+bool acqAllOK();
+bool acqProbe();                 // contrôle périodique (watchdog) ; met à jour l'état de présence
+const char* acqBackendName();
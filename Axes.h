@@ -0,0 +1,140 @@
+// Axes.h — Topologie des 8 axes décrite une seule fois (constexpr)
+#pragma once
+#include <stdint.h>
+#include <utility>
+#include "Hal.h"
+
+enum AxisIdx { AX_X=0, AX_Y, AX_Z, AX_LX, AX_LY, AX_LZ, AX_R1, AX_R2, AX_COUNT=8 };
+constexpr const char* AXIS_NAMES[AX_COUNT] = { "X","Y","Z","LX","LY","LZ","R1","R2" };   // journal, JSON
+
+// ads/ch : entrée ADS1115 (0 = 0x48 gauche, 1 = 0x49 droit, 2 = 0x4A, 3 = 0x4B) ; inverted : 32767 - brut
+//          (CAN SPI : voie ACQ_SPI_CHANNELS, inversion identique)
+// pwm/tor : paire de sorties PCA9685, voie globale = carte*16 + canal (carte b à 0x40+b)
+// Cartes, ordre de scrutation et rafales de sortie sont déduits de cette table : les 8
+// axes peuvent être répartis sur 4 ADS1115 (16 entrées) et 4 PCA9685 (64 voies).
+// Limite : AX_COUNT reste 8. Commandes manette (PadMap), mises en page EEPROM
+// (calibration, bridage), pages du portail et trame de télémétrie sont écrites pour
+// ces 8 sections nommées ; une machine de 10 à 16 sections n'est pas prise en charge.
+struct AxisWiring { uint8_t ads, ch; bool inverted; uint8_t pwm, tor; };
+
+// AXES_WIRING (-D, mêmes 8 entrées entre accolades) remplace la table ci-dessous :
+// autre machine ou banc réparti sur plus de cartes (CMakeLists.txt, pvg32_bench_spread).
+#ifdef AXES_WIRING
+constexpr AxisWiring AXES[AX_COUNT] = AXES_WIRING;
+#else
+constexpr AxisWiring AXES[AX_COUNT] = {
+  /* X  */ {1,2,false, 0, 9},
+  /* Y  */ {1,1,false, 1, 8},
+  /* Z  */ {1,0,false, 2,10},
+  /* LX */ {0,1,false, 3,11},
+  /* LY */ {0,2,true , 4,12},
+  /* LZ */ {0,0,true , 5,13},
+  /* R1 */ {1,3,true , 6,14},
+  /* R2 */ {0,3,true , 7,15},
+};
+#endif
+
+// ---------------- Vérifications de câblage (à la compilation) ----------------
+static_assert(AX_COUNT == 8, "AX_COUNT : 8 sections seulement (voir plus haut)");
+namespace axes_check {
+constexpr bool inputsInRange(){ for(const auto& a:AXES) if(a.ads>=HAL_ADS_COUNT || a.ch>=4) return false; return true; }
+constexpr bool inputsUnique(){
+  for(int i=0;i<AX_COUNT;i++) for(int j=i+1;j<AX_COUNT;j++)
+    if(AXES[i].ads==AXES[j].ads && AXES[i].ch==AXES[j].ch) return false;
+  return true;
+}
+constexpr bool outputsUnique(){
+  for(int i=0;i<AX_COUNT;i++){
+    if(AXES[i].pwm>=HAL_PCA_COUNT*16 || AXES[i].tor>=HAL_PCA_COUNT*16 || AXES[i].pwm==AXES[i].tor) return false;
+    for(int j=i+1;j<AX_COUNT;j++){
+      uint8_t a[2]={AXES[i].pwm,AXES[i].tor}, b[2]={AXES[j].pwm,AXES[j].tor};
+      for(uint8_t x:a) for(uint8_t y:b) if(x==y) return false;
+    }
+  }
+  return true;
+}
+}
+static_assert(axes_check::inputsInRange(), "AXES : ADS ou canal hors plage");
+static_assert(axes_check::inputsUnique(),  "AXES : même entrée ADS utilisée par deux axes");
+static_assert(axes_check::outputsUnique(), "AXES : sortie PCA9685 partagée ou hors plage");
+
+// ---------------- Sorties LEDC (OUTPUT_BACKEND == OUTPUT_LEDC) ----------------
+constexpr int8_t OUT_PWM_PIN[AX_COUNT] = OUT_PWM_PINS;
+constexpr int8_t OUT_TOR_PIN[AX_COUNT] = OUT_TOR_PINS;
+namespace axes_check {
+constexpr bool pinReserved(int8_t p){
+  return p==I2C_SDA || p==I2C_SCL || p==MODE_SEL_PIN || p==CAL_BTN_PIN || p==LED_VERTE_PIN
+      || p==LED_ROUGE_PIN || p==GPIO_MANETTE_CONNECTEE || p==LAT_MARKER_PIN || p>=34   // 34..39 : entrées seules
+      || (p>=6 && p<=11)                                                               // 6..11 : flash SPI
+      || (I2C_DUAL_BUS && (p==I2C1_SDA || p==I2C1_SCL));
+}
+constexpr bool outPinsValid(){
+  int8_t all[2*AX_COUNT] = {};
+  for(int i=0;i<AX_COUNT;i++){ all[i]=OUT_PWM_PIN[i]; all[AX_COUNT+i]=OUT_TOR_PIN[i]; }
+  for(int i=0;i<2*AX_COUNT;i++){
+    if(all[i]<0) continue;
+    if(pinReserved(all[i])) return false;
+    for(int j=i+1;j<2*AX_COUNT;j++) if(all[i]==all[j]) return false;
+  }
+  return true;
+}
+}
+static_assert(OUTPUT_BACKEND != OUTPUT_LEDC || axes_check::outPinsValid(),
+              "OUT_PWM_PINS/OUT_TOR_PINS : broche partagée, réservée ou entrée seule");
+
+static_assert(!I2C_DUAL_BUS || OUTPUT_BACKEND == OUTPUT_PCA9685, "I2C_DUAL_BUS : PCA9685 requis (OUTPUT_BACKEND)");
+static_assert(!I2C_DUAL_BUS || (I2C1_SDA!=I2C1_SCL && I2C1_SDA<34 && I2C1_SCL<34
+              && I2C1_SDA!=I2C_SDA && I2C1_SDA!=I2C_SCL && I2C1_SCL!=I2C_SDA && I2C1_SCL!=I2C_SCL),
+              "I2C1_SDA/I2C1_SCL : broches distinctes du premier bus, sorties possibles");
+
+// ---------------- CAN SPI (ACQ_BACKEND == ACQ_SPI_ADC) ----------------
+constexpr uint8_t ACQ_SPI_CH[AX_COUNT] = ACQ_SPI_CHANNELS;
+namespace axes_check {
+constexpr bool spiChannelsValid(){
+  for(int i=0;i<AX_COUNT;i++){
+    if(ACQ_SPI_CH[i]>=8) return false;
+    for(int j=i+1;j<AX_COUNT;j++) if(ACQ_SPI_CH[i]==ACQ_SPI_CH[j]) return false;
+  }
+  return true;
+}
+// MISO peut être une entrée seule (34..39) ; aucune broche commune avec les sorties LEDC
+constexpr bool spiPinsValid(){
+  int8_t p[4] = { ACQ_SPI_SCK, ACQ_SPI_MOSI, ACQ_SPI_CS, ACQ_SPI_MISO };
+  for(int i=0;i<4;i++){
+    if(p[i]<0 || p[i]>39 || (pinReserved(p[i]) && !(i==3 && p[i]>=34))) return false;
+    for(int j=i+1;j<4;j++) if(p[i]==p[j]) return false;
+    if(OUTPUT_BACKEND == OUTPUT_LEDC)
+      for(int k=0;k<AX_COUNT;k++) if(p[i]==OUT_PWM_PIN[k] || p[i]==OUT_TOR_PIN[k]) return false;
+  }
+  return true;
+}
+}
+static_assert(ACQ_BACKEND != ACQ_SPI_ADC || axes_check::spiChannelsValid(), "ACQ_SPI_CHANNELS : voie hors 0..7 ou partagée");
+static_assert(ACQ_BACKEND != ACQ_SPI_ADC || axes_check::spiPinsValid(),
+              "ACQ_SPI_* : broche partagée, réservée ou utilisée par les sorties LEDC");
+
+// ---------------- Grandeurs déduites de la table ----------------
+// Nombre de cartes ADS / PCA réellement câblées (indice max + 1)
+constexpr uint8_t axesAdsUsed(){ uint8_t n=0; for(const auto& a:AXES) if(a.ads+1>n) n=a.ads+1; return n; }
+constexpr uint8_t axesPcaBoards(){
+  uint8_t n=0;
+  for(const auto& a:AXES){ uint8_t b=(a.pwm>a.tor? a.pwm : a.tor)/16 + 1; if(b>n) n=b; }
+  return n;
+}
+// Tour de scrutation d'un axe = son rang parmi les axes de la même carte ADS.
+// Un tour lance une conversion sur chaque carte puis les relit : les cartes convertissent en parallèle.
+constexpr uint8_t axesScanRound(int i){ uint8_t r=0; for(int j=0;j<i;j++) if(AXES[j].ads==AXES[i].ads) r++; return r; }
+constexpr uint8_t axesScanRounds(){ uint8_t n=0; for(int i=0;i<AX_COUNT;i++) if(axesScanRound(i)+1>n) n=axesScanRound(i)+1; return n; }
+
+constexpr uint8_t AXES_ADS_USED    = (ACQ_BACKEND == ACQ_ADS1115)? axesAdsUsed() : 0;       // aucune carte en SPI
+constexpr uint8_t AXES_PCA_BOARDS  = (OUTPUT_BACKEND == OUTPUT_PCA9685)? axesPcaBoards() : 0;   // aucune carte en LEDC
+constexpr uint8_t AXES_SCAN_ROUNDS = axesScanRounds();
+static_assert(AXES_SCAN_ROUNDS <= 4, "AXES : plus de 4 axes sur une même carte ADS");
+
+// ---------------- Déroulage à la compilation ----------------
+// axesForEach([&](auto ax){ constexpr uint8_t i = decltype(ax)::value; ... });
+// génère AX_COUNT appels avec un indice constant : pas de boucle ni de lecture de table.
+template<typename F, size_t... I>
+inline void axesForEachImpl(F&& f, std::index_sequence<I...>){ (f(std::integral_constant<uint8_t,(uint8_t)I>{}), ...); }
+template<typename F>
+inline void axesForEach(F&& f){ axesForEachImpl(f, std::make_index_sequence<AX_COUNT>{}); }
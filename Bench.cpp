@@ -0,0 +1,893 @@
+// Bench.cpp — Micro-benchmarks des chemins chauds (mapping, sorties, JSON)
+#include "Bench.h"
+#if BENCH_ENABLE
+#include "Hal.h"
+#include "IOMap.h"
+#include "Controllers.h"
+#include "Calibration.h"
+#include "Bridage.h"
+#include "FaultsPortal.h"
+#include "PadMap.h"
+#include "Curve.h"
+#include "CmdQueue.h"
+#include "Output.h"
+#include "Acq.h"
+#include "I2cSched.h"
+#include "Faults.h"
+#include "Trace.h"
+#include "Power.h"
+#include "Ramp.h"
+#include "Latency.h"
+#include "Log.h"
+#include <algorithm>
+
+#if !HAL_SIM
+#error "BENCH_ENABLE requiert HAL_SIM=1 (E/S simulées)"
+#endif
+
+static const int BENCH_RUNS   = 7;     // séries ; on garde min et médiane
+static const int BENCH_ITERS  = 2000;  // appels par série
+static const int BENCH_INPUTS = 256;   // entrées pré-générées (puissance de 2)
+
+// ---------------- Vérifications ----------------
+static uint32_t failures = 0, scenarioFails = 0;
+#define BENCH_CHECK(cond, ...) do{ if(!(cond)){ scenarioFails++; LOGE(LT_BENCH, "ÉCHEC " __VA_ARGS__); } }while(0)
+static void scenarioEnd(const char* name){
+  LOGI(LT_BENCH, "%s %s", scenarioFails? "FAIL" : "PASS", name);
+  failures += scenarioFails; scenarioFails = 0;
+}
+uint32_t benchFailures(){ return failures; }
+
+// ---------------- Compteur d'allocations ----------------
+// Carte : hooks présents seulement si l'IDF est compilé avec CONFIG_HEAP_USE_HOOKS ;
+// hôte : malloc/new remplacés par host/HostAlloc.cpp. Sinon la colonne affiche "-".
+#ifdef CONFIG_HEAP_USE_HOOKS
+#include <esp_heap_caps.h>
+static volatile uint32_t allocCount = 0;
+extern "C" void esp_heap_trace_alloc_hook(void*, size_t, uint32_t){ allocCount++; }
+extern "C" void esp_heap_trace_free_hook(void*){}
+static uint32_t allocNow(){ return allocCount; }
+static const bool ALLOC_TRACKED = true;
+#elif !defined(ARDUINO_ARCH_ESP32)
+uint32_t hostAllocCount();
+static uint32_t allocNow(){ return hostAllocCount(); }
+static const bool ALLOC_TRACKED = true;
+#else
+static uint32_t allocNow(){ return 0; }
+static const bool ALLOC_TRACKED = false;
+#endif
+
+// ---------------- Entrées réalistes (déterministes) ----------------
+static uint32_t rng = 0x2545F491u;
+static uint32_t xorshift(){ rng ^= rng<<13; rng ^= rng>>17; rng ^= rng<<5; return rng; }
+
+// 70 % autour du neutre (bruit ±60), 30 % sur toute la course (ADS 3,3 V ≈ 0..17600)
+static int16_t rawSample(){
+  uint32_t r = xorshift();
+  if((r % 10) < 7) return (int16_t)(8800 + (int)((r>>8) % 121) - 60);
+  return (int16_t)((r>>8) % 17600);
+}
+static int16_t padStick(){
+  uint32_t r = xorshift();
+  if((r % 10) < 7) return (int16_t)((int)((r>>8) % 17) - 8);
+  return (int16_t)((int)((r>>8) % 1024) - 512);
+}
+
+static int16_t inRaw[BENCH_INPUTS];
+static ADSRaw  inFrame[BENCH_INPUTS];
+static int     inVal[BENCH_INPUTS];
+static PadSample inPad[BENCH_INPUTS];
+static volatile int sink;
+
+// ---------------- Mesure ----------------
+typedef void (*BenchFn)(int i);
+
+static uint32_t cyclesToNs(uint32_t cycles, uint32_t iters){
+  return (uint32_t)((uint64_t)cycles * 1000ULL / getCpuFrequencyMhz() / iters);
+}
+
+// hot : chemin de la boucle de commande, aucune allocation tolérée
+static void benchOne(const char* name, BenchFn fn, int iters, bool hot = false){
+  uint32_t ns[BENCH_RUNS];
+  uint32_t allocs = 0;
+  for(int i=0;i<iters/10;i++) fn(i & (BENCH_INPUTS-1));   // échauffement (caches, flash)
+  for(int r=0;r<BENCH_RUNS;r++){
+    uint32_t a0 = allocNow();
+    uint32_t c0 = ESP.getCycleCount();
+    for(int i=0;i<iters;i++) fn(i & (BENCH_INPUTS-1));
+    uint32_t c1 = ESP.getCycleCount();
+    allocs += allocNow() - a0;
+    ns[r] = cyclesToNs(c1-c0, iters);
+  }
+  std::sort(ns, ns+BENCH_RUNS);
+  char al[16];
+  if(ALLOC_TRACKED) snprintf(al, sizeof(al), "%.1f", (float)allocs / (float)(iters*BENCH_RUNS));
+  else snprintf(al, sizeof(al), "-");
+  LOGI(LT_BENCH, "%-22s %8lu %8lu %6s", name, (unsigned long)ns[0], (unsigned long)ns[BENCH_RUNS/2], al);
+  BENCH_CHECK(!(ALLOC_TRACKED && hot && allocs), "%s : %lu allocation(s) sur %d appels", name, (unsigned long)allocs, iters*BENCH_RUNS);
+  vTaskDelay(pdMS_TO_TICKS(20));   // laisse la tâche de journal vider l'anneau
+}
+
+// ---------------- Cas ----------------
+static void bMapOne(int i){ sink = mapADSWithCal(inRaw[i], cal[i & 7]); }
+static void bMapAll(int i){ Axes8 a = mapADSAll(inFrame[i]); sink = a.v[AX_X] + a.v[AX_R2]; }
+static void bApply(int i){ applyAxisToPair(i & 7, inVal[i], true); outCommit(); }
+static void bPadValues(int i){ halSimPadSet(0, inPad[i]); controllersUpdate(); int v[AX_COUNT]; sink = getPadValues(v, 0) + v[AX_X]; }
+static void bPadNeutral(int i){ halSimPadSet(0, inPad[i]); controllersUpdate(); sink = controllerAxesNeutral(0); }
+static void bAxesJson(int){ String s = calAxesJson(); sink = s.length(); }
+static void bPadCsv(int){ String s = bridagePadCsv(); sink = s.length(); }
+static void bStatusJson(int){ String s = faultsStatusJson(); sink = s.length(); }
+static void bTrace(int i){ TRACE_SCOPE(TR_CMD); sink = i; }
+static uint32_t traceBytes = 0, traceTsMin = UINT32_MAX, traceTsMax = 0;
+// Les morceaux s'arrêtent entre deux événements : un "ts" n'est jamais coupé
+static void traceCount(const char* b, size_t n){
+  traceBytes += n;
+  for(size_t p=0; p+5<n; p++) if(!memcmp(b+p, "\"ts\":", 5)){
+    uint32_t ts = (uint32_t)strtoul(b+p+5, nullptr, 10);
+    traceTsMin = std::min(traceTsMin, ts); traceTsMax = std::max(traceTsMax, ts);
+  }
+}
+
+// ---------------- Mapping filaire ----------------
+// mapADSAll (instantané, bornes MAP) = mapADSWithCal borné, axe par axe ;
+// neutre de calibration -> 512, courbe monotone de minV à maxV.
+static void mapScenario(){
+  const EffectiveConfig& c = effCfg();
+  for(int n=0;n<BENCH_INPUTS;n++){
+    Axes8 a = mapADSAll(inFrame[n]);
+    for(uint8_t i=0;i<AX_COUNT;i++){
+      int ref = constrain(mapADSWithCal(inFrame[n].v[i], cal[i]), c.mapMin, c.mapMax);
+      BENCH_CHECK(a.v[i] == ref, "mapADSAll axe %u brut %d : %d, attendu %d", i, inFrame[n].v[i], a.v[i], ref);
+    }
+  }
+  BENCH_CHECK(mapADSWithCal(cal[0].midV, cal[0]) == 512, "neutre calibré -> %d, attendu 512", mapADSWithCal(cal[0].midV, cal[0]));
+  int prev = mapADSWithCal(0, cal[0]);
+  for(int raw=0; raw<=17600; raw+=16){
+    int v = mapADSWithCal((int16_t)raw, cal[0]);
+    BENCH_CHECK(v >= prev, "mapADSWithCal non monotone en %d (%d < %d)", raw, v, prev);
+    prev = v;
+  }
+  BENCH_CHECK(mapADSWithCal(0, cal[0]) == 255 && mapADSWithCal(17600, cal[0]) == 768, "butées %d..%d, attendu 255..768",
+              mapADSWithCal(0, cal[0]), mapADSWithCal(17600, cal[0]));
+  // Pentes précalculées (sans division) = map() sur toute l'échelle brute
+  ADSRaw f{};
+  for(int raw=0; raw<=32767; raw+=3){
+    for(uint8_t i=0;i<AX_COUNT;i++) f.v[i] = (int16_t)raw;
+    Axes8 a = mapADSAll(f, c);
+    for(uint8_t i=0;i<AX_COUNT;i++){
+      int ref = constrain(mapADSWithCal((int16_t)raw, cal[i]), c.mapMin, c.mapMax);
+      if(a.v[i] != ref){ BENCH_CHECK(false, "mapADSAll axe %u brut %d : %d, attendu %d", i, raw, a.v[i], ref); break; }
+    }
+  }
+  // Rapport cyclique (pentes précalculées) = interpolation de référence, filaire et manette
+  for(int w=0; w<2; w++) for(int val=c.mapMin; val<=c.mapMax; val++){
+    uint8_t i = (uint8_t)(val % AX_COUNT);
+    int nLo = w? c.joyNeutralMinAx[i] : c.joyNeutralMin, nHi = w? c.joyNeutralMaxAx[i] : c.joyNeutralMax;
+    int s = curveShape(i, val, c.mapMin, nLo, nHi, c.mapMax);
+    float duty = 0.5f;
+    if(val < nLo) duty = 0.25f + 0.25f * constrain((float)(s - c.mapMin) / (float)(nLo - c.mapMin), 0.0f, 1.0f);
+    else if(val > nHi) duty = 0.5f + 0.25f * constrain((float)(s - nHi) / (float)(c.mapMax - nHi), 0.0f, 1.0f);
+    duty = constrain(duty + c.offsetDuty, 0.0f, 1.0f);
+    int ref = (int)(duty * 4095.0f + 0.5f);
+    applyAxisToPair(i, val, w, c);
+    int got = outPwmState(i);
+    if(abs(got - ref) > 1 || outTorState(i) != (val < nLo || val > nHi)){
+      BENCH_CHECK(false, "rapport %s axe %u MAP %d : %d/%d, attendu %d/%d", w? "filaire" : "manette", i, val, got, outTorState(i),
+                  ref, val < nLo || val > nHi);
+      break;
+    }
+  }
+  neutralizeAllOutputs();
+  scenarioEnd("mapping filaire");
+}
+
+// ---------------- Courbes réglables ----------------
+// Expo 30 % construite = préréglage "expo 30%" ; toute cassure (même incohérente)
+// donne une courbe monotone qui garde butées et fenêtre neutre.
+static void curveScenario(){
+  const int LO=255, NLO=482, NHI=542, HI=768;
+  uint8_t savedId[AX_COUNT]; CurveParam savedP[AX_COUNT];
+  memcpy(savedId, curveId, sizeof(savedId)); memcpy(savedP, curveParam, sizeof(savedP));
+  curveId[0]=CURVE_EXPO_SOFT; curveCompile(0);
+  curveId[1]=CURVE_EXPO; curveParam[1].expo=30; curveCompile(1);
+  for(int v=LO; v<=HI; v++)
+    BENCH_CHECK(curveShape(0,v,LO,NLO,NHI,HI) == curveShape(1,v,LO,NLO,NHI,HI), "expo 30 construite ≠ préréglage en %d", v);
+  curveParam[1].expo=0; curveCompile(1);
+  for(int v=LO; v<=HI; v++) BENCH_CHECK(curveShape(1,v,LO,NLO,NHI,HI) == v, "expo 0 non linéaire en %d", v);
+
+  static const CurveParam KNEES[] = { {0,50,20,75,50}, {0,10,80,20,90}, {0,90,10,40,5}, {0,0,0,0,0}, {0,100,100,100,100}, {0,30,60,30,40} };
+  for(const CurveParam& k : KNEES){
+    curveId[1]=CURVE_KNEES; curveParam[1]=k; curveCompile(1);
+    int prev = curveShape(1,LO,LO,NLO,NHI,HI);
+    BENCH_CHECK(prev == LO && curveShape(1,HI,LO,NLO,NHI,HI) == HI, "cassures %u:%u %u:%u : butées déplacées", k.x1, k.y1, k.x2, k.y2);
+    for(int v=LO+1; v<=HI; v++){
+      int y = curveShape(1,v,LO,NLO,NHI,HI);
+      BENCH_CHECK(y >= prev, "cassures %u:%u %u:%u : non monotone en %d", k.x1, k.y1, k.x2, k.y2, v);
+      if(v>=NLO && v<=NHI) BENCH_CHECK(y == v, "cassures : fenêtre neutre modifiée en %d", v);
+      prev = y;
+    }
+  }
+  memcpy(curveId, savedId, sizeof(savedId)); memcpy(curveParam, savedP, sizeof(savedP)); curveCompileAll();
+  scenarioEnd("courbes réglables");
+}
+
+// ---------------- Équivalence PadMap / ancien map()+constrain() ----------------
+static void padReference(const PadSample& s, bool lxInv, int out[AX_COUNT]){
+  int lo[AX_COUNT], hi[AX_COUNT], n[AX_COUNT];
+  for(int i=0;i<AX_COUNT;i++){ const PadAxisCoef& c = effCfg().pad[i]; lo[i]=c.lo; hi[i]=c.hi; n[i]=(lo[i]+hi[i])/2; }
+  int rawLX = s.lx; if(lxInv) rawLX = -rawLX;
+  out[AX_X]  = constrain(map(s.rx,  -512, 512, lo[AX_X],  hi[AX_X]),  lo[AX_X],  hi[AX_X]);
+  out[AX_Y]  = constrain(map(s.ry,  -512, 512, lo[AX_Y],  hi[AX_Y]),  lo[AX_Y],  hi[AX_Y]);
+  out[AX_LX] = constrain(map(rawLX, -512, 512, lo[AX_LX], hi[AX_LX]), lo[AX_LX], hi[AX_LX]);
+  out[AX_LY] = constrain(map(s.ly,  -512, 512, lo[AX_LY], hi[AX_LY]), lo[AX_LY], hi[AX_LY]);
+  out[AX_Z]  = n[AX_Z];
+  if(s.throttle>0)   out[AX_Z]=constrain(map(s.throttle,0,1023,n[AX_Z],lo[AX_Z]), lo[AX_Z], hi[AX_Z]);
+  else if(s.brake>0) out[AX_Z]=constrain(map(s.brake,   0,1023,n[AX_Z],hi[AX_Z]), lo[AX_Z], hi[AX_Z]);
+  out[AX_LZ]=n[AX_LZ]; if(s.dpad==PAD_DPAD_UP) out[AX_LZ]=hi[AX_LZ]; else if(s.dpad==PAD_DPAD_DOWN) out[AX_LZ]=lo[AX_LZ];
+  out[AX_R1]=n[AX_R1]; out[AX_R2]=n[AX_R2];
+  if(s.buttons&0x0001) out[AX_R1]=lo[AX_R1]; else if(s.buttons&0x0002) out[AX_R1]=hi[AX_R1];
+  if(s.buttons&0x0004) out[AX_R2]=lo[AX_R2]; else if(s.buttons&0x0008) out[AX_R2]=hi[AX_R2];
+}
+
+// Balaye toute la course des sticks/gâchettes pour plusieurs bridages : aucun écart admis
+static void padMapEquivalence(){
+  int savedMin[AX_COUNT], savedMax[AX_COUNT];
+  memcpy(savedMin, padMapMin[bridageProfile], sizeof(savedMin)); memcpy(savedMax, padMapMax[bridageProfile], sizeof(savedMax));
+  static const int16_t LIMITS[][2] = { {255,768}, {0,1023}, {400,620}, {300,300}, {512,900} };
+  uint32_t checked=0, diffs=0;
+  for(auto& lim : LIMITS){
+    for(int i=0;i<AX_COUNT;i++){ padMapMin[bridageProfile][i]=lim[0]; padMapMax[bridageProfile][i]=lim[1]; }
+    effCfgRebuild();
+    for(int x=-512; x<=511; x++){
+      PadSample s{}; s.lx=s.ly=s.rx=s.ry=(int16_t)x;
+      int t = (x+512);
+      if(x & 1) s.throttle=(int16_t)t; else s.brake=(int16_t)t;
+      s.dpad=(uint8_t)(x & 3); s.buttons=(uint16_t)(x & 0x0F);
+      for(int inv=0; inv<2; inv++){
+        int ref[AX_COUNT]; PadFrame f;
+        padReference(s, inv, ref); padMapCompute(s, inv, f);
+        checked++;
+        if(memcmp(ref, f.v, sizeof(ref))){ if(!diffs) LOGW(LT_BENCH, "PadMap écart x=%d inv=%d", x, inv); diffs++; }
+      }
+    }
+  }
+  // Trame partagée (getPadValues) : recalculée au rapport suivant et au changement de bridage
+  halSimPadConnect(0); controllersUpdate();
+  for(int n=0;n<64;n++){
+    halSimPadSet(0, inPad[n]); controllersUpdate();
+    int ref[AX_COUNT], v[AX_COUNT];
+    padReference(inPad[n], false, ref);
+    BENCH_CHECK(getPadValues(v, 0) && !memcmp(ref, v, sizeof(ref)), "getPadValues ≠ map()+constrain() (entrée %d)", n);
+    if(n == 63){
+      for(int i=0;i<AX_COUNT;i++){ padMapMin[bridageProfile][i]=400; padMapMax[bridageProfile][i]=620; }
+      effCfgRebuild();
+      padReference(inPad[n], false, ref);
+      BENCH_CHECK(getPadValues(v, 0) && !memcmp(ref, v, sizeof(ref)), "getPadValues : trame périmée après changement de bridage");
+    }
+  }
+  halSimPadDisconnect(0); controllersUpdate();
+  memcpy(padMapMin[bridageProfile], savedMin, sizeof(savedMin)); memcpy(padMapMax[bridageProfile], savedMax, sizeof(savedMax));
+  effCfgRebuild();
+  LOGI(LT_BENCH, "PadMap équivalence : %lu trames, %lu écart(s)", (unsigned long)checked, (unsigned long)diffs);
+  BENCH_CHECK(diffs == 0, "PadMap : %lu trame(s) différentes de map()+constrain()", (unsigned long)diffs);
+  scenarioEnd("PadMap = map()+constrain()");
+}
+
+// ---------------- Rapports pendant l'attente de fin de tick ----------------
+// Seul un rapport de la manette principale est appliqué hors boucle ;
+// un rapport du secours attend le tour suivant.
+static void eventScenario(){
+  halSimSetPin(MODE_SEL_PIN, HIGH);
+  halSimPadConnect(0); halSimPadConnect(1);
+  halSimPadSet(0, PadSample{}); halSimPadSet(1, PadSample{}); controllersUpdate(); processControllers();
+  int prim = controllersPrimarySlot(), stby = controllersStandbySlot();
+  BENCH_CHECK(prim == 0 && stby == 1, "slots principale=%d secours=%d, attendu 0/1", prim, stby);
+  PadSample moved{}; moved.ly = 200;
+  uint32_t n0 = controllersEventCommits();
+  halSimPadSet(1, moved); controllersWaitEvents();
+  BENCH_CHECK(controllersEventCommits() == n0, "rapport du secours appliqué hors boucle (%lu)", (unsigned long)(controllersEventCommits()-n0));
+  halSimPadSet(0, moved); controllersWaitEvents();
+  BENCH_CHECK(controllersEventCommits() == n0+1, "rapport de la principale : %lu application(s), attendu 1", (unsigned long)(controllersEventCommits()-n0));
+  halSimPadDisconnect(0); halSimPadDisconnect(1); controllersUpdate();
+  halSimSetPin(MODE_SEL_PIN, LOW);
+  scenarioEnd("rapports en attente de tick");
+}
+
+// ---------------- Bascule manette principale → secours ----------------
+// Deux manettes simulées en mode manette : bascule acceptée (secours neutre)
+// puis refusée (secours hors neutre). Durée mesurée du décrochage à l'écriture PCA.
+static void failoverScenario(){
+  halSimSetPin(MODE_SEL_PIN, HIGH);
+  halSimPadConnect(0); halSimPadConnect(1);
+  halSimPadSet(0, PadSample{}); halSimPadSet(1, PadSample{}); controllersUpdate();
+  for(uint32_t t=0; t<=FAILOVER_NEUTRAL_MS+10; t+=5){ halDelay(5); processControllers(); }
+  safetyReady = true; halDigitalWrite(GPIO_MANETTE_CONNECTEE, true); processControllers();
+
+  uint32_t c0 = ESP.getCycleCount();
+  halSimPadDisconnect(0); controllersUpdate();
+  uint32_t ns = cyclesToNs(ESP.getCycleCount()-c0, 1);
+  LOGI(LT_BENCH, "bascule secours neutre  : %s, principale=%d, %lu ns", safetyReady?"ARMÉ":"désarmé", controllersPrimarySlot(), (unsigned long)ns);
+  BENCH_CHECK(safetyReady && controllersPrimarySlot() == 1, "secours neutre : %s, principale=%d, attendu ARMÉ sur le slot 1",
+              safetyReady?"ARMÉ":"désarmé", controllersPrimarySlot());
+
+  PadSample moved{}; moved.lx = 400;
+  halSimPadConnect(0); controllersUpdate(); halSimPadSet(0, moved); controllersUpdate();
+  for(uint32_t t=0; t<=FAILOVER_NEUTRAL_MS+10; t+=5){ halDelay(5); processControllers(); }
+  halSimPadDisconnect(1); controllersUpdate();
+  BENCH_CHECK(!safetyReady, "secours déplacé : reste ARMÉ, attendu désarmé");
+  BENCH_CHECK(halDigitalRead(GPIO_MANETTE_CONNECTEE) == LOW, "secours déplacé : sortie « manette connectée » restée haute");
+
+  safetyReady = false;
+  halSimPadDisconnect(0); controllersUpdate();
+  halSimSetPin(MODE_SEL_PIN, LOW);
+  scenarioEnd("bascule principale -> secours");
+}
+
+// Profils de bridage : SELECT + → au neutre (armé), refus axes déplacés, démarrage sur 0.
+// Durée = trame complète processControllers() qui change de profil et commite.
+static void profileScenario(){
+  if(BRIDAGE_PROFILES < 2) return;
+  halSimSetPin(MODE_SEL_PIN, HIGH);
+  halSimPadConnect(0); controllersUpdate(); processControllers();
+  safetyReady = true;
+  uint8_t p0 = bridageProfile;
+  PadSample sel{}; sel.misc = PAD_MISC_SELECT; sel.dpad = PAD_DPAD_RIGHT;
+  halSimPadSet(0, sel); controllersUpdate();
+  uint32_t c0 = ESP.getCycleCount();
+  processControllers();
+  uint32_t ns = cyclesToNs(ESP.getCycleCount()-c0, 1);
+  PadSample full{}; full.rx = 511; halSimPadSet(0, full); controllersUpdate(); processControllers();
+  int v[AX_COUNT]; getPadValues(v, 0);
+  LOGI(LT_BENCH, "profil manette : %s -> %s en %lu ns, X plein = %d (borne %ld)", bridageProfileName(p0),
+       bridageProfileName(bridageProfile), (unsigned long)ns, v[AX_X], (long)effCfg().pad[AX_X].hi);
+  BENCH_CHECK(bridageProfile == (p0 + 1) % BRIDAGE_PROFILES, "SELECT+droite : profil %u, attendu %u",
+              (unsigned)bridageProfile, (unsigned)((p0 + 1) % BRIDAGE_PROFILES));
+  BENCH_CHECK(abs(v[AX_X] - effCfg().pad[AX_X].hi) <= 1, "X plein = %d hors borne %ld du nouveau profil",
+              v[AX_X], (long)effCfg().pad[AX_X].hi);
+
+  uint8_t p1 = bridageProfile;
+  sel.rx = 400; halSimPadSet(0, sel); controllersUpdate(); processControllers();
+  BENCH_CHECK(bridageProfile == p1, "profil changé axes hors neutre (%u -> %u)", (unsigned)p1, (unsigned)bridageProfile);
+
+  // Une sauvegarde sans rapport ne fait pas du profil actif le profil de démarrage
+  bridageSaveToEEPROM(); bridageLoadOrDefault(); effCfgRebuild();
+  BENCH_CHECK(bridageProfile == 0, "démarrage sur le profil %u après sauvegarde, attendu 0", (unsigned)bridageProfile);
+
+  bridageSelectProfile(p0);
+  safetyReady = false;
+  halSimPadDisconnect(0); controllersUpdate();
+  halSimSetPin(MODE_SEL_PIN, LOW);
+  scenarioEnd("profils manette (SELECT+flèches, démarrage)");
+}
+
+// Valeur brute vue par un axe après inversion éventuelle, quelle que soit l'acquisition
+// (CAN SPI 12 bits : au pas de ACQ_RAW_LSB près)
+#if ACQ_BACKEND == ACQ_SPI_ADC
+static const int ACQ_RAW_LSB = 8;
+#else
+static const int ACQ_RAW_LSB = 1;
+#endif
+static void setAxisRaw(uint8_t i, int v){
+  int raw = AXES[i].inverted? 32767 - v : v;
+#if ACQ_BACKEND == ACQ_SPI_ADC
+  halSimSetSpiAdc(ACQ_SPI_CH[i], (uint16_t)(raw >> 3));
+#else
+  halSimSetAds(AXES[i].ads, AXES[i].ch, (int16_t)raw);
+#endif
+}
+static void setAllAxesRaw(int v){ for(uint8_t i=0;i<AX_COUNT;i++) setAxisRaw(i, v); }
+
+// Repos : manette désarmée immobile POWER_IDLE_AFTER_MS, puis rapport pendant
+// l'attente d'un tick lent ; l'attente doit s'écourter au tick rapide. En filaire,
+// le tick reste rapide au repos et un stick réveille dès le scan suivant.
+static void powerScenario(){
+#if POWER_IDLE_ENABLE
+  halSimSetPin(MODE_SEL_PIN, HIGH);
+  halSimPadConnect(0); controllersUpdate();
+  powerBegin(); powerStatsReset();
+  halDelay(POWER_IDLE_AFTER_MS); powerUpdate();
+  BENCH_CHECK(powerIdle() && halSimPowerIdle() && powerTickMs() == POWER_IDLE_TICK_MS, "repos manette non atteint");
+  uint32_t t0 = halMillis();
+  PadSample moved{}; moved.lx = 300; halSimPadSet(0, moved);
+  controllersWaitEvents();
+  powerUpdate();
+  uint32_t waitMs = halMillis() - t0;
+  BENCH_CHECK(!powerIdle() && !halSimPowerIdle() && waitMs <= powerTickMs() + 1,
+              "rapport manette au repos : fin d'attente %lu ms, CPU %s", (unsigned long)waitMs, halSimPowerIdle()? "ralenti" : "nominal");
+  powerStatsPrint();
+  halSimPadDisconnect(0); controllersUpdate();
+  halSimSetPin(MODE_SEL_PIN, LOW);
+
+  setAllAxesRaw(8800);
+  powerBegin(); powerStatsReset();
+  halDelay(POWER_IDLE_AFTER_MS); processADS(); powerUpdate();
+  BENCH_CHECK(powerIdle() && powerTickMs() < POWER_IDLE_TICK_MS, "repos filaire : %s, tick %lu ms",
+              powerIdle()? "atteint" : "NON atteint", (unsigned long)powerTickMs());
+  setAxisRaw(AX_X, 14000);
+  t0 = halMillis();
+  controllersWaitEvents(); waitMs = halMillis() - t0;
+  processADS(); powerUpdate();
+  BENCH_CHECK(!powerIdle() && waitMs <= powerTickMs() + 1, "stick au repos filaire : %s, attente %lu ms",
+              powerIdle()? "NON réveillé" : "réveillé", (unsigned long)waitMs);
+  setAllAxesRaw(8800); processADS();
+  powerBegin(); powerStatsReset();
+  scenarioEnd("repos (réveil manette et stick)");
+#endif
+}
+
+// Reconnexion : manette hors liste blanche écartée par la pile Bluetooth, puis
+// chronologie prêt → manette → armé (PS maintenu 5 s) sur la manette acceptée.
+static void reconnectScenario(){
+  static const uint8_t OK_ADDR[6] = {0x11,0x22,0x33,0x44,0x55,0x66}, KO_ADDR[6] = {0xAA,0xBB,0xCC,0xDD,0xEE,0xFF};
+  controllersSetAllowList("11:22:33:44:55:66");
+  controllersBootDone();
+  halSimSetPin(MODE_SEL_PIN, HIGH);
+  halSimPadSetAddress(0, OK_ADDR); halSimPadSetAddress(1, KO_ADDR);
+  uint32_t bt0 = halSimPadBtRefused();
+  halDelay(250); halSimPadConnect(0); halSimPadConnect(1); controllersUpdate();
+  BENCH_CHECK(halPadConnected(0), "liste blanche : manette autorisée refusée");
+  BENCH_CHECK(!halPadConnected(1) && halSimPadBtRefused() == bt0 + 1, "liste blanche : manette hors liste non écartée par la pile");
+  BENCH_CHECK(halSimPadKeysForgotten() == (PAD_KEEP_BONDS? 0u : 1u), "clés effacées x%lu avec PAD_KEEP_BONDS=%d",
+              (unsigned long)halSimPadKeysForgotten(), PAD_KEEP_BONDS);
+
+  // Filet applicatif : pile sans filtre, la manette hors liste est déconnectée et sa clé effacée
+  uint32_t f0 = halSimPadAddrForgotten();
+  halPadSetAllowList(nullptr, 0);
+  halSimPadConnect(1); controllersUpdate();
+  BENCH_CHECK(!halPadConnected(1) && halSimPadAddrForgotten() == f0 + 1, "liste blanche : refus applicatif sans effacement de clé");
+
+  PadSample ps{}; ps.misc = PAD_MISC_SYSTEM;
+  halSimPadSet(0, ps); controllersUpdate();
+  uint32_t t0 = halMillis();
+  for(uint32_t t=0; t<5100 && !safetyReady; t+=5){ halDelay(5); processControllers(); }
+  BENCH_CHECK(safetyReady && halMillis() - t0 >= 5000, "armement : %s après %lu ms (PS maintenu 5 s)",
+              safetyReady? "armé" : "non armé", (unsigned long)(halMillis() - t0));
+  String tl = controllersTimelineJson();
+  BENCH_CHECK(tl.indexOf("\"armedMs\":0,") < 0 && tl.indexOf("\"refused\":1}") >= 0, "chronologie : %s", tl.c_str());
+
+  safetyReady = false;
+  halSimPadDisconnect(0); controllersUpdate();
+  halSimSetPin(MODE_SEL_PIN, LOW);
+  static const uint8_t NONE[6] = {0};
+  halSimPadSetAddress(0, NONE); halSimPadSetAddress(1, NONE);
+  controllersSetAllowList(PAD_ALLOW_LIST);
+  scenarioEnd("reconnexion (liste blanche, armement)");
+}
+
+// File portail → boucle : file pleine, application à la frontière de tour, accusés
+// (décalage +10 puis rétabli, sans EEPROM)
+static void cmdQueueScenario(){
+  int off0 = neutralOffset;
+  Cmd c{}; c.type = CMD_NEUTRAL_OFFSET; c.offset.val = (int16_t)(off0 + 10); c.offset.save = false;
+  uint32_t first = 0, last = 0, refused = 0;
+  for(int k=0;k<CMD_QUEUE_DEPTH+1;k++){ uint32_t id = cmdPost(c); if(!id) refused++; else { if(!first) first=id; last=id; } }
+  CmdAck before = cmdAckStatus(last);
+  BENCH_CHECK(last-first+1 == CMD_QUEUE_DEPTH && refused == 1, "file commandes : %lu postées, %lu refusée(s) pour %u places",
+              (unsigned long)(last-first+1), (unsigned long)refused, (unsigned)CMD_QUEUE_DEPTH);
+  BENCH_CHECK(before == ACK_PENDING && neutralOffset == off0, "file commandes : appliquée avant la frontière de tour");
+  halDelay(5);                 // un tour de loop()
+  cmdApplyPending();
+  BENCH_CHECK(cmdAckStatus(first) == ACK_DONE && cmdAckStatus(last) == ACK_DONE && neutralOffset == off0 + 10,
+              "file commandes : accusés %u/%u, décalage %d attendu %d", cmdAckStatus(first), cmdAckStatus(last), neutralOffset, off0 + 10);
+  BENCH_CHECK(cmdPost(c) != 0, "file commandes : toujours pleine après application");
+  c.offset.val = (int16_t)off0; cmdPost(c); cmdApplyPending();
+  BENCH_CHECK(neutralOffset == off0, "file commandes : décalage non rétabli (%d)", neutralOffset);
+  cmdStatsPrint();
+  cmdStatsReset();
+  scenarioEnd("file commandes portail -> boucle");
+}
+
+// Mode manette : aucun scan de contrôle ; le portail lit les axes et le watchdog sonde.
+// Chaque tour commence par le commit des sorties, le diagnostic passe derrière.
+static void i2cSchedScenario(){
+  // Un axe par conversion, relue au tour suivant : borne à partir de la durée nominale
+  const int maxTicks = AX_COUNT * (int)(1000000u / ADS_DATA_RATE_SPS / 5000u + 3);
+  for(int k=0;k<maxTicks;k++){ i2cService(); halDelay(5); }   // relecture laissée par les scénarios précédents
+  halDelay(ADS_DIAG_MAX_AGE_MS + 50);   // dernier scan trop ancien
+  i2cStatsReset();
+  uint32_t t0 = halMicros(); int ticks = 0; bool done = false;
+  i2cRuntimeWatchdog();
+  while(!done && ticks < maxTicks){
+    ticks++;
+    for(uint8_t i=0;i<AX_COUNT;i++) applyAxisToPair(i, (ticks&1)? 400 : 600, false);
+    outCommit();
+    adsDiagRaw();
+    i2cService();
+    halDelay(5);
+    done = (int32_t)(adsLastRaw().tAcqUs[AX_COUNT-1] - t0) > 0;
+  }
+  LOGI(LT_BENCH, "ordonnanceur I2C : relecture portail %s en %d tour(s)", done? "complète" : "INCOMPLÈTE", ticks);
+  BENCH_CHECK(done, "relecture portail incomplète après %d tours", ticks);
+  // Diagnostic servi en fin du tour où il est posté (< 2 ticks de 5 ms), sans imbrication ni refus
+  BENCH_CHECK(i2cWaitMaxUs(I2C_DIAG) < 10000u, "diag : attente max %lu us",
+              (unsigned long)i2cWaitMaxUs(I2C_DIAG));
+  BENCH_CHECK(i2cConflicts() == 0, "bus : %lu conflit(s)/refus", (unsigned long)i2cConflicts());
+  i2cStatsPrint();
+  i2cStatsReset();
+  scenarioEnd("ordonnanceur I2C (priorités, attente diag)");
+}
+
+// Calibration par balayage : leviers menés lentement (pas < GROW_RAW par scan)
+// jusqu'aux butées 600 / 17000 et tenus ; aucune butée ne doit être acquise en
+// cours de course, et le dernier levier doit être suivi jusqu'au retour au neutre.
+static void calStep(){ processCalibration(); halDelay(5); }
+static void calRamp(int from, int to){
+  int step = (to > from)? CAL_SWEEP_GROW_RAW/2 : -CAL_SWEEP_GROW_RAW/2;
+  for(int v=from; (step>0)? v<to : v>to; v+=step){ setAllAxesRaw(v); calStep(); }
+  setAllAxesRaw(to); calStep();
+}
+static void calHold(uint32_t ms){ uint32_t t0 = halMillis(); while(calibMode && halMillis()-t0 < ms) calStep(); }
+
+static void calSweepScenario(){
+#if CAL_SWEEP_ENABLE
+  uint8_t savedHalf[AX_COUNT]; memcpy(savedHalf, calNeutralHalf, sizeof(savedHalf));
+  setAllAxesRaw(8800);
+  startCalibration();
+  uint32_t t0 = halMillis();
+  while(calibMode && calPhase != CAL_PHASE_SWEEP && halMillis()-t0 < 20000) calStep();
+  BENCH_CHECK(calPhase == CAL_PHASE_SWEEP, "calibration : balayage non atteint (phase %u)", (unsigned)calPhase);
+  calRamp(8800, 600);
+  bool loEarly = false; for(int i=0;i<AX_COUNT;i++) loEarly |= haveMin[i];
+  BENCH_CHECK(!loEarly, "calibration : MIN acquis pendant une poussée lente");
+  calHold(CAL_SWEEP_STABLE_MS + 500);
+  calRamp(600, 17000);
+  calHold(CAL_SWEEP_STABLE_MS + 500);
+  BENCH_CHECK(calPhase == CAL_PHASE_FINISH, "calibration : balayage non terminé aux butées (phase %u)", (unsigned)calPhase);
+  calRamp(17000, 8800);
+  calHold(2000);
+  BENCH_CHECK(!calibMode, "calibration : pas terminée au retour au neutre");
+  for(int i=0;i<AX_COUNT;i++)
+    BENCH_CHECK(abs(cal[i].minV - 600) < ACQ_RAW_LSB && abs(cal[i].maxV - 17000) < ACQ_RAW_LSB, "calibration : axe %d butées %d..%d, attendu 600..17000",
+                i, cal[i].minV, cal[i].maxV);
+  if(calibMode) finishCalibration();
+  memcpy(calNeutralHalf, savedHalf, sizeof(savedHalf));
+  setAllAxesRaw(16384);
+  scenarioEnd("calibration par balayage");
+#endif
+}
+
+// Latence acquisition → commit : délai connu inséré entre la lecture (ou le rapport manette)
+// et l'écriture des sorties ; n, moyenne, max et casier doivent se retrouver dans /lat.json.
+// Un échantillon non horodaté (tAcqUs == 0) est ignoré.
+static long latField(const String& j, uint8_t src, uint8_t axis, const char* key, int idx = -1){
+  char k[24];
+  snprintf(k, sizeof(k), "\"%s\":[", src == LAT_SRC_ADS? "ads" : "pad");
+  int p = j.indexOf(String(k));
+  for(uint8_t a=0; p>=0 && a<=axis; a++) p = j.indexOf(String("{\"axis\""), p+1);
+  snprintf(k, sizeof(k), "\"%s\":%s", key, idx>=0? "[" : "");
+  int q = (p<0)? -1 : j.indexOf(String(k), p);
+  if(q<0) return -1;
+  q += strlen(k);
+  for(int n=0; n<idx && q>0; n++) q = j.indexOf(',', q) + 1;
+  return j.substring(q).toInt();
+}
+static int latBucketOf(uint32_t us){ int k = 0; while(us > 1 && k < LAT_BUCKETS-1){ us >>= 1; k++; } return k; }
+static void latCheck(const String& j, uint8_t src, uint8_t i, uint32_t dtMin, uint32_t dtMax){
+  long n = latField(j, src, i, "n"), mean = latField(j, src, i, "mean"), mx = latField(j, src, i, "max");
+  long b = latField(j, src, i, "hist", latBucketOf((uint32_t)mx));
+  BENCH_CHECK(n == 1 && mean == mx && mx >= (long)dtMin && mx <= (long)dtMax && b == 1,
+              "latence %s axe %s : n=%ld moy=%ld max=%ld casier=%ld, attendu 1 x %lu..%lu us", src == LAT_SRC_ADS? "ads" : "pad",
+              AXIS_NAMES[i], n, mean, mx, b, (unsigned long)dtMin, (unsigned long)dtMax);
+}
+static void latencyScenario(){
+  const uint32_t DELAY_US = 3000;
+  latReset();
+  ADSRaw rr = readADSRaw();
+  halSimAdvance(DELAY_US);
+  const EffectiveConfig& c = effCfg();
+  Axes8 a = mapADSAll(rr, c);
+  for(uint8_t i=0;i<AX_COUNT;i++) applyAxisToPair(i, a.v[i], true, c);
+  outCommit();
+  uint32_t tc = halMicros();
+  for(uint8_t i=0;i<AX_COUNT;i++) latRecord(LAT_SRC_ADS, i, a.tAcqUs[i]);
+  latRecord(LAT_SRC_ADS, AX_X, 0);
+  String j = latJson();
+  for(uint8_t i=0;i<AX_COUNT;i++) latCheck(j, LAT_SRC_ADS, i, tc - rr.tAcqUs[i], tc - rr.tAcqUs[i]);
+
+  // Manette armée : rapport reçu, DELAY_US plus tard le tour l'applique ; une réapplication ne compte pas
+  bool armed0 = safetyReady;
+  halSimSetPin(MODE_SEL_PIN, HIGH);
+  halSimPadConnect(0); halSimPadSet(0, PadSample{}); controllersUpdate(); processControllers();
+  latReset(); safetyReady = true;
+  PadSample moved{}; moved.lx = 200; halSimPadSet(0, moved); controllersUpdate();
+  uint32_t tr = halMicros();
+  halSimAdvance(DELAY_US); processControllers();
+  tc = halMicros();
+  processControllers();
+  j = latJson();
+  for(uint8_t i=0;i<AX_COUNT;i++) latCheck(j, LAT_SRC_PAD, i, DELAY_US, tc - tr);
+  safetyReady = armed0;
+  halSimPadDisconnect(0); controllersUpdate();
+  halSimSetPin(MODE_SEL_PIN, LOW);
+  neutralizeAllOutputs(); latReset();
+  scenarioEnd("latence acquisition -> commit (/lat.json)");
+}
+
+// Calibration sous bruit connu (±A pas bruts, uniforme : sigma = A/√3) : la demi-fenêtre
+// neutre suit CAL_NEUTRAL_SIGMA_K·sigma converti en points MAP, bornée à MIN..MAX_HALF.
+// ADS seulement (bruit simulé sur les conversions), et assez de scans sur la phase neutre.
+static void calNoiseScenario(){
+#if CAL_SWEEP_ENABLE && ACQ_BACKEND == ACQ_ADS1115 && ADS_DATA_RATE_SPS >= 128
+  static const uint16_t NOISE[] = { 0, 100, 300, 1000 };
+  uint8_t savedHalf[AX_COUNT]; memcpy(savedHalf, calNeutralHalf, sizeof(savedHalf));
+  uint8_t prev[AX_COUNT] = {};
+  for(uint16_t a : NOISE){
+    halSimSetAdsNoise(a);
+    setAllAxesRaw(8800);
+    startCalibration();
+    uint32_t t0 = halMillis();
+    while(calibMode && calPhase != CAL_PHASE_SWEEP && halMillis()-t0 < 20000) calStep();
+    calRamp(8800, 600);   calHold(CAL_SWEEP_STABLE_MS + 500);
+    calRamp(600, 17000);  calHold(CAL_SWEEP_STABLE_MS + 500);
+    calRamp(17000, 8800); calHold(5000);
+    BENCH_CHECK(!calibMode, "calibration bruit ±%u : pas terminée au neutre (phase %u)", a, (unsigned)calPhase);
+    if(calibMode) finishCalibration();
+    for(uint8_t i=0;i<AX_COUNT;i++){
+      float k = 256.0f / (float)std::min(cal[i].midV - cal[i].minV, cal[i].maxV - cal[i].midV);
+      float sigma = (float)a / sqrtf(3.0f * ADS_OVERSAMPLE);
+      int lo = constrain((int)ceilf(0.7f * CAL_NEUTRAL_SIGMA_K * sigma * k) + CAL_NEUTRAL_MARGIN, CAL_NEUTRAL_MIN_HALF, CAL_NEUTRAL_MAX_HALF);
+      int hi = constrain((int)ceilf(1.3f * CAL_NEUTRAL_SIGMA_K * sigma * k) + CAL_NEUTRAL_MARGIN, CAL_NEUTRAL_MIN_HALF, CAL_NEUTRAL_MAX_HALF);
+      uint8_t h = calNeutralHalf[i];
+      BENCH_CHECK(h >= lo && h <= hi && h >= prev[i], "calibration bruit ±%u : axe %u neutre ±%u, attendu %d..%d (≥ %u)",
+                  a, i, h, lo, hi, prev[i]);
+      prev[i] = h;
+    }
+  }
+  for(uint8_t i=0;i<AX_COUNT;i++)
+    BENCH_CHECK(prev[i] == CAL_NEUTRAL_MAX_HALF, "calibration bruit ±%u : axe %u neutre ±%u, attendu la borne %u",
+                NOISE[3], i, prev[i], (unsigned)CAL_NEUTRAL_MAX_HALF);
+  halSimSetAdsNoise(0);
+  memcpy(calNeutralHalf, savedHalf, sizeof(savedHalf));
+  setAllAxesRaw(16384);
+  scenarioEnd("calibration sous bruit (fenêtre neutre)");
+#endif
+}
+
+// Tour filaire simulé (scan + commit). Bus unique : la rafale PCA s'ajoute au scan ;
+// bus double : elle recouvre le scan suivant et passe sur Wire1. Wire1 muet => défaut
+// général attribué au bus PCA.
+// Rampes : pleine course en rampAccelMs, retour au neutre en rampDecelMs (à un tick
+// près), arrêt au neutre avant de changer de côté, 0 ms = consigne telle quelle ;
+// neutralizeAllOutputs() coupe une rampe en cours et la fait repartir du neutre.
+static uint32_t rampRun(int target, int& v){
+  const uint32_t TICK_US = 5000;
+  uint32_t t0 = halMicros();
+  for(int k=0; k<200 && v!=target; k++){ halSimAdvance(TICK_US); v = rampStep(0, target); }
+  return (halMicros() - t0) / 1000;
+}
+static void rampScenario(){
+  const int TICK_MS = 5, ACC = 200, DEC = 110;
+  uint16_t acc0 = rampAccelMs[0], dec0 = rampDecelMs[0];
+  rampAccelMs[0] = ACC; rampDecelMs[0] = DEC;
+  const int n = effCfg().neutralOffset, hi = n + 256, lo = n - 256;
+  rampReset(); int v = rampStep(0, n);
+  uint32_t ms = rampRun(hi, v);
+  BENCH_CHECK(v == hi && ms + TICK_MS >= (uint32_t)ACC && ms <= (uint32_t)ACC + TICK_MS, "rampe accel : %d en %lu ms, attendu %d en %d ms", v, (unsigned long)ms, hi, ACC);
+  ms = rampRun(n, v);
+  BENCH_CHECK(v == n && ms + TICK_MS >= (uint32_t)DEC && ms <= (uint32_t)DEC + TICK_MS, "rampe decel : %d en %lu ms, attendu %d en %d ms", v, (unsigned long)ms, n, DEC);
+  // Inversion : les pas descendent jusqu'au neutre exact, puis repartent en accel
+  // (premier pas sous le neutre = pas d'accel, pas le reste d'un pas de decel)
+  rampRun(hi, v);
+  bool hitN = false, overshoot = false;
+  int below = n;
+  uint32_t t0 = halMicros(), tN = 0;
+  for(int k=0; k<200 && v!=lo; k++){
+    halSimAdvance(TICK_MS*1000); v = rampStep(0, lo);
+    if(!hitN && v < n) overshoot = true;
+    if(!hitN && v == n){ hitN = true; tN = (halMicros() - t0) / 1000; }
+    if(below == n && v < n) below = v;
+  }
+  uint32_t tLo = (halMicros() - t0) / 1000;
+  BENCH_CHECK(hitN && !overshoot && n - below <= 256*TICK_MS/ACC + 1 && v == lo && tN <= (uint32_t)DEC + TICK_MS && tLo + TICK_MS >= (uint32_t)(DEC + ACC),
+              "rampe inversion : neutre %s%s en %lu ms, premier pas %d, %d en %lu ms", hitN? "atteint" : "NON atteint",
+              overshoot? " (dépassé)" : "", (unsigned long)tN, below - n, v, (unsigned long)tLo);
+  rampAccelMs[0] = 0; rampDecelMs[0] = 0;
+  halSimAdvance(TICK_MS*1000); int a = rampStep(0, 700);
+  halSimAdvance(TICK_MS*1000); int b = rampStep(0, 300);
+  BENCH_CHECK(a == 700 && b == 300, "rampe 0 ms : %d puis %d, attendu 700 puis 300", a, b);
+  // Coupure en pleine rampe : PWM 50 % et TOR relâché au même commit
+  rampAccelMs[0] = ACC; rampDecelMs[0] = DEC;
+  rampReset(); rampStep(0, n);
+  for(int k=0;k<10;k++){ halSimAdvance(TICK_MS*1000); applyAxisToPair(0, rampStep(0, hi), true); }
+  outCommit();
+  uint16_t mid = outPwmState(0); bool torMid = outTorState(0);
+  neutralizeAllOutputs();
+  int pwm = outPwmState(0) - OUT_PWM_FULL/2;
+  BENCH_CHECK(mid > OUT_PWM_FULL/2 && torMid && pwm >= -1 && pwm <= 1 && !outTorState(0),
+              "neutralisation en rampe : %u/%d -> %u/%d, attendu %u/0", mid, torMid, outPwmState(0), outTorState(0), OUT_PWM_FULL/2);
+  int v0 = rampStep(0, hi);
+  halSimAdvance(TICK_MS*1000); v = rampStep(0, hi);
+  BENCH_CHECK(v0 == n && v > n && v < n + 256*TICK_MS/ACC + 2, "rampe après neutralisation : %d puis %d, attendu %d puis un pas", v0, v, n);
+  rampAccelMs[0] = acc0; rampDecelMs[0] = dec0;
+  rampReset(); neutralizeAllOutputs();
+  scenarioEnd("rampes (accel, decel, inversion, neutralisation)");
+}
+
+static void wiredLoopScenario(){
+  uint32_t busUs0 = halSimPcaBusUs(), scanUs = 0;
+#if I2C_DUAL_BUS
+  uint32_t b0 = halSimPcaBursts(), x0, x1, e;
+  halI2CBusStats(1, x0, e);
+#endif
+  uint32_t w0 = halMicros();
+  for(int k=0;k<20;k++){
+    uint32_t s0 = halMicros();
+    ADSRaw t = readADSRaw(); Axes8 a = mapADSAll(t);
+    scanUs += halMicros() - s0;
+    for(uint8_t i=0;i<AX_COUNT;i++) applyAxisToPair(i, a.v[i] + ((k&1)? 40 : -40), true);
+    outCommit();
+  }
+  uint32_t wall = halMicros() - w0, serial = scanUs + (halSimPcaBusUs() - busUs0);
+  LOGI(LT_BENCH, "tour filaire simulé : %lu us, scan + rafale en série %lu us (%s)", (unsigned long)(wall/20),
+       (unsigned long)(serial/20), I2C_DUAL_BUS? "ADS sur Wire, PCA sur Wire1" : "bus unique");
+#if I2C_DUAL_BUS
+  halI2CBusStats(1, x1, e);
+  BENCH_CHECK(wall < serial, "bus double : tour %lu us, pas plus court que scan + rafale (%lu us)",
+              (unsigned long)wall, (unsigned long)serial);
+  BENCH_CHECK(HAL_I2C_PCA == 1 && x1 - x0 == halSimPcaBursts() - b0, "bus double : %lu transfert(s) Wire1 pour %lu rafale(s)",
+              (unsigned long)(x1 - x0), (unsigned long)(halSimPcaBursts() - b0));
+  // Wire1 muet : la sonde suivante lève N5 avec le bus PCA en cause, puis l'efface au retour
+  halSimSetBusDown(1, true);
+  halDelay(2600); i2cRuntimeWatchdog(); i2cService();
+  BENCH_CHECK(faultCode == FC_I2C_GENERAL && strstr(faultsBusDetail(), "PCA (Wire1)"), "Wire1 muet : défaut %u, détail \"%s\"",
+              (unsigned)faultCode, faultsBusDetail());
+  halSimSetBusDown(1, false);
+  halDelay(2600); i2cRuntimeWatchdog(); i2cService();
+  BENCH_CHECK(faultCode == FC_NONE && !*faultsBusDetail(), "Wire1 rétabli : défaut %u", (unsigned)faultCode);
+#else
+  BENCH_CHECK(wall >= serial, "bus unique : tour %lu us plus court que scan + rafale (%lu us)", (unsigned long)wall, (unsigned long)serial);
+#endif
+  scenarioEnd("tour filaire (bus I2C)");
+}
+
+void benchRun(){
+  // Calibration typique (gain 2/3, joystick 3,3 V) le temps du banc
+  CalAxis saved[AX_COUNT]; memcpy(saved, cal, sizeof(saved));
+  for(int i=0;i<AX_COUNT;i++){ cal[i].minV=600; cal[i].midV=8800; cal[i].maxV=17000; }
+  effCfgRebuild();
+
+  for(int i=0;i<BENCH_INPUTS;i++){
+    inRaw[i] = rawSample();
+    for(int k=0;k<AX_COUNT;k++) inFrame[i].v[k] = rawSample();
+    inVal[i] = mapADSWithCal(inRaw[i], cal[0]);
+    PadSample& s = inPad[i];
+    s = PadSample{};
+    s.lx=padStick(); s.ly=padStick(); s.rx=padStick(); s.ry=padStick();
+    uint32_t r = xorshift();
+    if((r & 7) == 0) s.throttle = (int16_t)((r>>4) % 1024);
+    if((r & 15) == 1) s.buttons = 0x0001;
+  }
+
+  mapScenario();
+  curveScenario();
+  padMapEquivalence();
+
+  // Durée d'un scan en temps de bus simulé (ADS : conversions entrelacées entre cartes)
+  uint32_t s0 = halMicros(); ADSRaw scan = readADSRaw(); sink = scan.v[0];
+#if ACQ_BACKEND == ACQ_SPI_ADC
+  LOGI(LT_BENCH, "scan %s : %lu us simulés, %u axes, %u trame(s) DMA", acqBackendName(),
+       (unsigned long)(halMicros()-s0), (unsigned)AX_COUNT, (unsigned)ADS_OVERSAMPLE);
+  // CAN simulé : voie → axe, mise à l'échelle et inversion ; puis CAN retiré du bus
+  for(uint8_t i=0;i<AX_COUNT;i++) halSimSetSpiAdc(ACQ_SPI_CH[i], (uint16_t)(500 + 400*i));
+  scan = readADSRaw();
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    int16_t exp = (int16_t)((500 + 400*i) << 3); if(AXES[i].inverted) exp = (int16_t)(32767 - exp);
+    BENCH_CHECK(scan.v[i] == exp, "CAN SPI : axe %u (voie %u) lu %d, attendu %d", i, (unsigned)ACQ_SPI_CH[i], scan.v[i], exp);
+  }
+  uint32_t f0 = halSimSpiFrames(); scan = readADSRaw();
+  BENCH_CHECK(halSimSpiFrames() - f0 == ADS_OVERSAMPLE, "CAN SPI : %lu trame(s) par scan, attendu %u",
+              (unsigned long)(halSimSpiFrames() - f0), (unsigned)ADS_OVERSAMPLE);
+  halSimSetSpiAdcPresent(false); bool absentSeen = !acqProbe();
+  halSimSetSpiAdcPresent(true); bool backSeen = acqProbe();
+  BENCH_CHECK(absentSeen && backSeen, "CAN SPI : absence %s, retour %s", absentSeen? "détectée" : "NON détectée",
+              backSeen? "détecté" : "NON détecté");
+  for(uint8_t i=0;i<AX_COUNT;i++) halSimSetSpiAdc(i, 2048);
+  scenarioEnd("CAN SPI simulé (voies, trames, absence)");
+#else
+  uint32_t scanUs = halMicros() - s0;
+  LOGI(LT_BENCH, "scan %s : %lu us simulés, %u axes, %u cartes, %u tours", acqBackendName(),
+       (unsigned long)scanUs, (unsigned)AX_COUNT, (unsigned)AXES_ADS_USED, (unsigned)AXES_SCAN_ROUNDS);
+  // Les cartes convertissent en parallèle : un scan dure AXES_SCAN_ROUNDS conversions, pas AX_COUNT
+  const uint32_t convUs = 1000000UL / ADS_DATA_RATE_SPS * ADS_OVERSAMPLE;
+  BENCH_CHECK(scanUs >= AXES_SCAN_ROUNDS*convUs && scanUs < (AXES_SCAN_ROUNDS+1u)*convUs,
+              "scan ADS : %lu us pour %u tour(s) de %lu us (%u cartes)", (unsigned long)scanUs,
+              (unsigned)AXES_SCAN_ROUNDS, (unsigned long)convUs, (unsigned)AXES_ADS_USED);
+  // Sondage après la durée nominale de conversion : au plus 2 relectures du registre par conversion
+  uint32_t p0 = halSimAdsPolls(); scan = readADSRaw(); sink = scan.v[0];
+  uint32_t polls = halSimAdsPolls() - p0;
+  BENCH_CHECK(polls <= 2u*AX_COUNT*ADS_OVERSAMPLE, "scan ADS : %lu sondages pour %u conversions", (unsigned long)polls, (unsigned)(AX_COUNT*ADS_OVERSAMPLE));
+  // Aucune conversion hors délai quel que soit ADS_DATA_RATE_SPS (hors délai = neutre 16384)
+  for(uint8_t i=0;i<AX_COUNT;i++) halSimSetAds(AXES[i].ads, AXES[i].ch, (int16_t)(3000 + 1000*i));
+  scan = readADSRaw();
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    int16_t exp = (int16_t)(3000 + 1000*i); if(AXES[i].inverted) exp = (int16_t)(32767 - exp);
+    BENCH_CHECK(scan.v[i] == exp, "scan ADS %u SPS : axe %u lu %d, attendu %d", (unsigned)ADS_DATA_RATE_SPS, i, scan.v[i], exp);
+  }
+  for(uint8_t i=0;i<AX_COUNT;i++) halSimSetAds(AXES[i].ads, AXES[i].ch, 16384);
+  scenarioEnd("scan ADS (sondage, délais)");
+#endif
+  // Bruit mesuré sur 200 scans avec ±40 pas bruts simulés
+  halSimSetAdsNoise(40); adsNoiseReset();
+  for(int k=0;k<200;k++){ ADSRaw n = readADSRaw(); sink = n.v[0]; }
+  halSimSetAdsNoise(0); adsNoisePrint(); adsNoiseReset();
+  // Commit des sorties : trafic émis et conformité de ce que le faux enregistreur a reçu
+  // (départ au neutre : chaque carte a des voies modifiées, donc une rafale chacune)
+  neutralizeAllOutputs();
+  uint32_t b0 = halSimPcaBursts(), l0 = halSimLedcWrites();
+  for(uint8_t i=0;i<AX_COUNT;i++) applyAxisToPair(i, (i&1)? 700 : 300, isEffectiveWiredMode());
+  outCommit();
+  for(uint8_t i=0;i<AX_COUNT;i++){
+#if OUTPUT_BACKEND == OUTPUT_LEDC
+    uint32_t got = (OUT_PWM_PIN[i] >= 0)? halSimLedcDuty(OUT_PWM_PIN[i]) : outPwmState(i);
+    bool tor = (OUT_TOR_PIN[i] >= 0)? halDigitalRead(OUT_TOR_PIN[i]) == HIGH : outTorState(i);
+#else
+    uint32_t got = halSimPcaOff(AXES[i].pwm);
+    bool tor = halSimPcaFullOn(AXES[i].tor);
+#endif
+    BENCH_CHECK(got == outPwmState(i) && tor == outTorState(i), "commit %s : axe %u reçu %lu/%d, demandé %u/%d", outBackendName(),
+                i, (unsigned long)got, tor, outPwmState(i), outTorState(i));
+  }
+  uint32_t bursts = halSimPcaBursts()-b0, ledc = halSimLedcWrites()-l0;
+  LOGI(LT_BENCH, "commit %s : %u voies, %lu rafale(s) I2C, %lu écriture(s) LEDC", outBackendName(),
+       (unsigned)(2*AX_COUNT), (unsigned long)bursts, (unsigned long)ledc);
+#if OUTPUT_BACKEND == OUTPUT_LEDC
+  BENCH_CHECK(bursts == 0 && ledc > 0, "commit LEDC : %lu rafale(s) I2C, %lu écriture(s) LEDC", (unsigned long)bursts, (unsigned long)ledc);
+#else
+  BENCH_CHECK(bursts == AXES_PCA_BOARDS && ledc == 0, "commit PCA : %lu rafale(s) pour %u carte(s), %lu écriture(s) LEDC",
+              (unsigned long)bursts, (unsigned)AXES_PCA_BOARDS, (unsigned long)ledc);
+#endif
+  scenarioEnd("commit des sorties (enregistreur)");
+  // Tour filaire simulé (scan + commit) : en bus double, la rafale PCA recouvre le scan suivant
+  wiredLoopScenario();
+  halSimPadConnect(0); halPadUpdate();
+
+  LOGI(LT_BENCH, "%-22s %8s %8s %6s", "cas", "ns min", "ns med", "alloc");
+  benchOne("mapADSWithCal",        bMapOne,     BENCH_ITERS, true);
+  benchOne("mapADSAll",            bMapAll,     BENCH_ITERS, true);
+  benchOne("applyAxisToPair",      bApply,      BENCH_ITERS, true);
+  uint8_t savedCurve[AX_COUNT]; memcpy(savedCurve, curveId, sizeof(savedCurve));
+  for(auto& c:curveId) c=CURVE_EXPO_STRONG;
+  curveCompileAll();
+  benchOne("applyAxisToPair expo", bApply,      BENCH_ITERS, true);
+  memcpy(curveId, savedCurve, sizeof(savedCurve)); curveCompileAll();
+  benchOne("getPadValues",         bPadValues,  BENCH_ITERS, true);
+  benchOne("controllerAxesNeutral",bPadNeutral, BENCH_ITERS, true);
+  benchOne("json /axes.json",      bAxesJson,   BENCH_ITERS/10);
+  benchOne("csv /pad",             bPadCsv,     BENCH_ITERS/10);
+  benchOne("json /status.json",    bStatusJson, BENCH_ITERS/10);
+  benchOne("traceSpan",            bTrace,      BENCH_ITERS, true);
+  scenarioEnd("chemins chauds sans allocation");
+  uint32_t nEvt = traceExport(traceCount);
+  LOGI(LT_BENCH, "export trace : %lu événements, %lu octets JSON", (unsigned long)nEvt, (unsigned long)traceBytes);
+#if TRACE_ENABLE
+  BENCH_CHECK(nEvt > 0 && traceBytes > 0, "export trace vide");
+  // Parent écrit après son enfant, enfant en tête de fenêtre : origine = début du parent
+  traceReset(); traceTsMin = UINT32_MAX; traceTsMax = 0;
+  { TRACE_SCOPE(TR_TICK); halDelayUs(100); { TRACE_SCOPE(TR_CMD); halDelayUs(50); } }
+  nEvt = traceExport(traceCount);
+  BENCH_CHECK(nEvt == 2 && traceTsMin == 0 && traceTsMax >= 100 && traceTsMax < 3600000000u,
+              "export trace imbriqué : %lu événements, ts %lu..%lu us", (unsigned long)nEvt,
+              (unsigned long)traceTsMin, (unsigned long)traceTsMax);
+  scenarioEnd("export trace");
+#endif
+  traceReset();
+
+  halSimPadDisconnect(0); halPadUpdate();
+  eventScenario();
+  failoverScenario();
+  profileScenario();
+  powerScenario();
+  reconnectScenario();
+  cmdQueueScenario();
+  i2cSchedScenario();
+  calSweepScenario();
+  calNoiseScenario();
+  latencyScenario();
+  rampScenario();
+  memcpy(cal, saved, sizeof(saved));
+  effCfgRebuild();
+  neutralizeAllOutputs();
+  LOGI(LT_BENCH, "banc : %lu échec(s)", (unsigned long)failures);
+}
+
+#endif
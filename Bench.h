@@ -0,0 +1,14 @@
+// Bench.h — Micro-benchmarks des chemins chauds (mapping, sorties, JSON)
+#pragma once
+#include "Config.h"
+
+// Compilé uniquement si BENCH_ENABLE (Config.h). Nécessite HAL_SIM=1 :
+// les E/S sont simulées, on mesure le calcul seul, pas le bus I2C.
+// Lancé une fois en fin de setup(), résultats sur le journal [BENCH] :
+//   nom | ns/op min | ns/op médian | allocations/op
+// Le minimum sur BENCH_RUNS séries est la valeur à suivre d'un commit à l'autre.
+// Les scénarios vérifient leurs attentes : chaque écart est journalisé (ÉCHEC),
+// chaque scénario conclut par une ligne PASS/FAIL. Cible hôte : pvg32_bench sort
+// avec le nombre d'échecs (ctest).
+void benchRun();
+uint32_t benchFailures();   // attentes non tenues depuis le démarrage
@@ -6,40 +6,63 @@
 #include "Led.h"  // pour readCalButton()
 #include "Config.h"
 #include "Controllers.h"
+#include "Log.h"
+#include "PadMap.h"
+#include "Ramp.h"
+#include "Curve.h"
+#include "CmdQueue.h"
+#include "EffConfig.h"
+#include "Trace.h"
 
-#define AX_COUNT 8
-#define NEUTRAL_HALF_WINDOW 30
 #define BRIDAGE_BASE_SPAN 513
 
 #define BRDG_EE_MAGIC      0xB1D6
-#define BRDG_EE_VER        0x0001
+#define BRDG_EE_VER        0x0006   // 0x0002 : + rampes accel/decel ; 0x0003 : + courbes ; 0x0004 : bornes au neutre 512 ; 0x0005 : + profils ; 0x0006 : + réglages de courbes
 #define BRDG_EE_SIZE       512
 #define BRDG_EE_MAGIC_ADDR 256
 #define BRDG_EE_VER_ADDR   258
 #define BRDG_EE_DATA_ADDR  260
+#define BRDG_EE_CURVE_ADDR (BRDG_EE_SIZE - AX_COUNT*(int)sizeof(CurveParam))   // fin de zone : indépendant de BRIDAGE_PROFILES
 
-int padMapMin[AX_COUNT]     = {255,255,255,255,255,255,255,255};
-int padMapMax[AX_COUNT]     = {768,768,768,768,768,768,768,768};
-int padNeutral[AX_COUNT]    = {512,512,512,512,512,512,512,512};
-int padNeutralMin[AX_COUNT] = {
-  512-NEUTRAL_HALF_WINDOW,512-NEUTRAL_HALF_WINDOW,512-NEUTRAL_HALF_WINDOW,512-NEUTRAL_HALF_WINDOW,
-  512-NEUTRAL_HALF_WINDOW,512-NEUTRAL_HALF_WINDOW,512-NEUTRAL_HALF_WINDOW,512-NEUTRAL_HALF_WINDOW
-};
-int padNeutralMax[AX_COUNT] = {
-  512+NEUTRAL_HALF_WINDOW,512+NEUTRAL_HALF_WINDOW,512+NEUTRAL_HALF_WINDOW,512+NEUTRAL_HALF_WINDOW,
-  512+NEUTRAL_HALF_WINDOW,512+NEUTRAL_HALF_WINDOW,512+NEUTRAL_HALF_WINDOW,512+NEUTRAL_HALF_WINDOW
-};
+// Bornes saisies, au neutre 512 : le décalage neutralOffset est appliqué par effCfgRebuild()
+int padMapMin[BRIDAGE_PROFILES][AX_COUNT];
+int padMapMax[BRIDAGE_PROFILES][AX_COUNT];
+uint8_t bridageProfile = 0;
+
+// Profil 0 = bornes des EEPROM < 0x0005 ; les autres partent d'une course réduite
+static const char* const PROFILE_NAME[] = { "plein", "fin", "moyen", "libre" };
+static const int16_t PROFILE_DEFAULT[][2] = { {255,768}, {384,640}, {320,704}, {255,768} };
+static_assert(BRIDAGE_PROFILES >= 1 && BRIDAGE_PROFILES <= 4, "BRIDAGE_PROFILES : 1..4");
+// Profils 1.. après les courbes : 260 + 72 + 1 + 3*32 = 429 octets au plus, réglages de courbes en 472..511
+static_assert(BRDG_EE_DATA_ADDR + AX_COUNT*9 + 1 + (BRIDAGE_PROFILES-1)*AX_COUNT*4 <= BRDG_EE_CURVE_ADDR, "EEPROM bridage trop petite");
+
+static void profileDefaults(uint8_t q){
+  for(int i=0;i<AX_COUNT;i++){ padMapMin[q][i]=PROFILE_DEFAULT[q][0]; padMapMax[q][i]=PROFILE_DEFAULT[q][1]; }
+}
+
+const char* bridageProfileName(uint8_t p){ return (p<BRIDAGE_PROFILES)? PROFILE_NAME[p] : "?"; }
 
 static inline int clampInt(int v,int lo,int hi){ if(v<lo) return lo; if(v>hi) return hi; return v; }
-static inline bool isPadMode(){ return digitalRead(MODE_SEL_PIN)==HIGH; } // HIGH = mode manette
+static inline bool isPadMode(){ return halDigitalRead(MODE_SEL_PIN)==HIGH; } // HIGH = mode manette
 
-void bridageRecalcNeutralForAxis(int i){
-  int n=(padMapMin[i]+padMapMax[i])/2;
-  padNeutral[i]=n;
-  padNeutralMin[i]=n-NEUTRAL_HALF_WINDOW;
-  padNeutralMax[i]=n+NEUTRAL_HALF_WINDOW;
+// Bornes saisies sur la page (0..1023, triées) pour le profil affiché au chargement de la page
+void bridageApplyLimits(uint8_t profile, const int16_t mn[AX_COUNT], const int16_t mx[AX_COUNT]){
+  if(profile>=BRIDAGE_PROFILES) return;
+  for(int i=0;i<AX_COUNT;i++){ padMapMin[profile][i]=clampInt(mn[i], 0, 1023); padMapMax[profile][i]=clampInt(mx[i], 0, 1023); }
+  effCfgRebuild();
+}
+
+bool bridageSelectProfile(uint8_t p){
+  if(p>=BRIDAGE_PROFILES) return false;
+  bridageProfile = p;
+  effCfgSelectProfile(p);
+  return true;
+}
+
+void bridageApplyRamps(const uint16_t up[AX_COUNT], const uint16_t down[AX_COUNT], const uint8_t* curve, const CurveParam* param){
+  for(int i=0;i<AX_COUNT;i++){ rampAccelMs[i]=up[i]; rampDecelMs[i]=down[i]; }
+  if(curve) for(int i=0;i<AX_COUNT;i++){ curveId[i]=curve[i]; if(param) curveParam[i]=param[i]; curveCompile(i); }
 }
-static void bridageRecalcAll(){ for(int i=0;i<AX_COUNT;i++) bridageRecalcNeutralForAxis(i); }
 
 void bridageSaveToEEPROM(){
 #if defined(ARDUINO_ARCH_ESP32)
@@ -48,12 +71,21 @@ void bridageSaveToEEPROM(){
   EEPROM.put(BRDG_EE_MAGIC_ADDR,(uint16_t)BRDG_EE_MAGIC);
   EEPROM.put(BRDG_EE_VER_ADDR,(uint16_t)BRDG_EE_VER);
   int addr=BRDG_EE_DATA_ADDR;
-  for(int i=0;i<AX_COUNT;i++){ int16_t v=(int16_t)padMapMin[i]; EEPROM.put(addr,v); addr+=2; }
-  for(int i=0;i<AX_COUNT;i++){ int16_t v=(int16_t)padMapMax[i]; EEPROM.put(addr,v); addr+=2; }
+  for(int i=0;i<AX_COUNT;i++){ int16_t v=(int16_t)padMapMin[0][i]; EEPROM.put(addr,v); addr+=2; }
+  for(int i=0;i<AX_COUNT;i++){ int16_t v=(int16_t)padMapMax[0][i]; EEPROM.put(addr,v); addr+=2; }
+  for(int i=0;i<AX_COUNT;i++){ EEPROM.put(addr,rampAccelMs[i]); addr+=2; }
+  for(int i=0;i<AX_COUNT;i++){ EEPROM.put(addr,rampDecelMs[i]); addr+=2; }
+  for(int i=0;i<AX_COUNT;i++){ EEPROM.put(addr,curveId[i]); addr+=1; }
+  EEPROM.put(addr,(uint8_t)0); addr+=1;       // ex-profil de démarrage : toujours 0 (réservé)
+  for(int q=1;q<BRIDAGE_PROFILES;q++){
+    for(int i=0;i<AX_COUNT;i++){ int16_t v=(int16_t)padMapMin[q][i]; EEPROM.put(addr,v); addr+=2; }
+    for(int i=0;i<AX_COUNT;i++){ int16_t v=(int16_t)padMapMax[q][i]; EEPROM.put(addr,v); addr+=2; }
+  }
+  for(int i=0;i<AX_COUNT;i++) EEPROM.put(BRDG_EE_CURVE_ADDR + i*(int)sizeof(CurveParam), curveParam[i]);
 #if defined(ARDUINO_ARCH_ESP32)
-  EEPROM.commit();
+  { TRACE_SCOPE(TR_FLASH); EEPROM.commit(); }
 #endif
-  Serial.println("[BRIDAGE] Sauvegarde EEPROM : OK");
+  LOGI(LT_BRIDAGE, "Sauvegarde EEPROM : OK");
 }
 
 static bool bridageLoadFromEEPROM(){
@@ -64,20 +96,45 @@ static bool bridageLoadFromEEPROM(){
   EEPROM.get(BRDG_EE_MAGIC_ADDR,magic);
   EEPROM.get(BRDG_EE_VER_ADDR,ver);
   if(magic!=BRDG_EE_MAGIC){
-    Serial.println("[BRIDAGE] EEPROM absente -> valeurs par défaut.");
+    LOGW(LT_BRIDAGE, "EEPROM absente -> valeurs par défaut.");
     return false;
   }
   int addr=BRDG_EE_DATA_ADDR;
-  for(int i=0;i<AX_COUNT;i++){ int16_t v; EEPROM.get(addr,v); addr+=2; padMapMin[i]=(int)v; }
-  for(int i=0;i<AX_COUNT;i++){ int16_t v; EEPROM.get(addr,v); addr+=2; padMapMax[i]=(int)v; }
-  Serial.printf("[BRIDAGE] Configuration chargée (ver=0x%04X).\n",ver);
+  // Avant 0x0004 les bornes étaient enregistrées déjà décalées de neutralOffset (chargé avant)
+  int shift = (ver<0x0004)? neutralOffset - 512 : 0;
+  for(int i=0;i<AX_COUNT;i++){ int16_t v; EEPROM.get(addr,v); addr+=2; padMapMin[0][i]=clampInt(v - shift, 0, 1023); }
+  for(int i=0;i<AX_COUNT;i++){ int16_t v; EEPROM.get(addr,v); addr+=2; padMapMax[0][i]=clampInt(v - shift, 0, 1023); }
+  if(ver>=0x0002){
+    for(int i=0;i<AX_COUNT;i++){ EEPROM.get(addr,rampAccelMs[i]); addr+=2; }
+    for(int i=0;i<AX_COUNT;i++){ EEPROM.get(addr,rampDecelMs[i]); addr+=2; }
+  }
+  if(ver>=0x0003){
+    for(int i=0;i<AX_COUNT;i++){ EEPROM.get(addr,curveId[i]); addr+=1; }
+    // Avant 0x0006 : préréglages seulement
+    if(ver<0x0006) for(int i=0;i<AX_COUNT;i++) if(curveId[i]>=CURVE_EXPO) curveId[i]=CURVE_LINEAR;
+  }
+  if(ver>=0x0005){
+    // Profils absents de l'EEPROM (BRIDAGE_PROFILES augmenté) : valeurs par défaut
+    addr+=1;   // ex-profil de démarrage, ignoré : démarrage toujours sur le profil 0
+    for(int q=1;q<BRIDAGE_PROFILES;q++){
+      int16_t mn[AX_COUNT], mx[AX_COUNT];
+      for(int i=0;i<AX_COUNT;i++){ EEPROM.get(addr,mn[i]); addr+=2; }
+      for(int i=0;i<AX_COUNT;i++){ EEPROM.get(addr,mx[i]); addr+=2; }
+      if(mn[0]<0 || mn[0]>1023) continue;
+      for(int i=0;i<AX_COUNT;i++){ padMapMin[q][i]=clampInt(mn[i], 0, 1023); padMapMax[q][i]=clampInt(mx[i], 0, 1023); }
+    }
+  }
+  if(ver>=0x0006) for(int i=0;i<AX_COUNT;i++) EEPROM.get(BRDG_EE_CURVE_ADDR + i*(int)sizeof(CurveParam), curveParam[i]);
+  curveCompileAll();
+  LOGI(LT_BRIDAGE, "Configuration chargée (ver=0x%04X), profil %s.",ver,bridageProfileName(bridageProfile));
   return true;
 }
 
 void bridageLoadOrDefault(){
-  bool ok=bridageLoadFromEEPROM();
-  if(!ok){ for(int i=0;i<AX_COUNT;i++){ padMapMin[i]=255; padMapMax[i]=768; } }
-  bridageRecalcAll();
+  rampSetDefaults(); curveSetDefaults();
+  for(uint8_t q=0;q<BRIDAGE_PROFILES;q++) profileDefaults(q);
+  bridageProfile = 0;
+  bridageLoadFromEEPROM();
 }
 
 static String navBar(){
@@ -94,11 +151,10 @@ static String navBar(){
 }
 
 static String htmlPage(){
+  auto csvU16=[&](const uint16_t *a){ String s=""; for(int i=0;i<AX_COUNT;i++){ if(i) s+=","; s+=String(a[i]); } return s; };
   auto csv=[&](int *a){ String s=""; for(int i=0;i<AX_COUNT;i++){ s+=String(a[i]); if(i<AX_COUNT-1) s+=","; } return s; };
-  int deltaFrom512 = neutralOffset - 512;
-  int dispMin[AX_COUNT], dispMax[AX_COUNT];
-  for(int i=0;i<AX_COUNT;i++){ dispMin[i]=padMapMin[i]-deltaFrom512; dispMax[i]=padMapMax[i]-deltaFrom512; }
-  String sMin=csv(dispMin), sMax=csv(dispMax);
+  uint8_t prof=bridageProfile;
+  String sMin=csv(padMapMin[prof]), sMax=csv(padMapMax[prof]);
 
   String html;
   html.reserve(18000);
@@ -130,24 +186,35 @@ static String htmlPage(){
   html += "<button id=\"btnFinish\">Fin de Bridage</button>";
   html += "<span id=\"msg\" class=\"muted\"></span>";
   html += "</div>";
+  html += "<div style='margin:10px 0'>Profil \u00E9dit\u00E9 : <b>" + String(bridageProfileName(prof)) + "</b> (" + String(prof+1) + "/" + String(BRIDAGE_PROFILES) + ")";
+  html += " <span class=\"muted\">&middot; manette : SELECT + \u2190/\u2192 au neutre</span></div>";
   html += "<div style='margin:10px 0'>D\u00E9calage neutre : <select id=\"off\"></select> <button id=\"saveOff\">Sauvegarde EEPROM</button></div>";
 
   html += "<table id=\"t\"><thead><tr>";
   html += "<th>Axe</th><th>Valeur mini</th><th>Valeur maxi</th><th>Plage neutre</th><th>Conseil</th><th>Valeurs enregistrées</th><th>Manette</th>";
   html += "</tr></thead><tbody id=\"tb\"></tbody></table>";
 
+  html += "<h3>Rampes (ms, 0 = instantan\u00E9) et courbes</h3>";
+  html += "<div class=\"bar\"><button id=\"btnRamp\">Envoyer rampes et courbes</button><span id=\"rmsg\" class=\"muted\"></span></div>";
+  html += "<table><thead><tr><th>Axe</th><th>Mont\u00E9e (neutre \u2192 maxi)</th><th>Retour (maxi \u2192 neutre)</th><th>Courbe</th><th>Expo % / cassures x:y x:y (%)</th></tr></thead><tbody id=\"rb\"></tbody></table>";
+
   html += "<script>";
+  html += portalAckJs();
+  html += "var RUP=[" + csvU16(rampAccelMs) + "], RDN=[" + csvU16(rampDecelMs) + "];";
+  html += "var CRV=["; for(int i=0;i<AX_COUNT;i++){ if(i) html += ","; html += String(curveId[i]); } html += "];";
+  html += "var CRVP=["; for(int i=0;i<AX_COUNT;i++){ const CurveParam& p=curveParam[i]; if(i) html += ","; html += "[" + String(p.expo) + "," + String(p.x1) + "," + String(p.y1) + "," + String(p.x2) + "," + String(p.y2) + "]"; } html += "];";
+  html += "var CRVN=["; for(int c=0;c<CURVE_COUNT;c++){ if(c) html += ","; html += "'"; html += curveName(c); html += "'"; } html += "];";
   html += "var AX=['X','Y','Z','LX','LY','LZ','R1','R2'];";
   html += "var Smin=[" + sMin + "];";
   html += "var Smax=[" + sMax + "];";
-  html += "var OFFSET=" + String(neutralOffset) + ";";
+  html += "var OFFSET=" + String(neutralOffset) + ", PROF=" + String(prof) + ";";
   html += "var ACTMIN=Smin.slice(), ACTMAX=Smax.slice();";
   html += "var PAD=[0,0,0,0,0,0,0,0];";
   html += "var touchedMin=[false,false,false,false,false,false,false,false];";
   html += "var touchedMax=[false,false,false,false,false,false,false,false];";
   html += "var lastChanged=['','','','','','','',''];";
   html += "function buildOffset(){ var o=''; for(var v=0; v<=1023; v++){ o+='<option value=\"'+v+'\"'+(v===OFFSET?' selected':'')+'>'+v+'</option>'; } document.getElementById('off').innerHTML=o; }";
-  html += "function applyOffset(save){ var v=document.getElementById('off').value; var u='/offset?val='+v; if(save) u+='&save=1'; fetch(u,{cache:'no-store'}).then(function(){ if(save) location.reload(); }); }";
+  html += "function applyOffset(save){ var v=document.getElementById('off').value; var u='/offset?val='+v; if(save) u+='&save=1'; fetch(u,{cache:'no-store'}).then(ackWait).then(function(){ if(save) location.reload(); }); }";
   html += "function clamp(v,lo,hi){ return Math.min(hi, Math.max(lo, v)); }";
   html += "function mkSelect(id,val){ var o=''; for(var v=0; v<=1023; v++){ o+='<option value=\"'+v+'\"'+(v===val?' selected':'')+'>'+v+'</option>'; } return '<select id=\"'+id+'\">'+o+'</select>'; }";
   html += "function neutralText(mn,mx){ var n=Math.round((mn+mx)/2); var nmin=clamp(n-30,0,1023); var nmax=clamp(n+30,0,1023); return nmin+' / '+nmax; }";
@@ -157,16 +224,29 @@ static String htmlPage(){
   html += "function collectCSV(){ var mins=[],maxs=[]; for(var i=0;i<8;i++){ mins.push(document.getElementById('min_'+i).value); maxs.push(document.getElementById('max_'+i).value);} return {min:mins.join(','), max:maxs.join(',')}; }";
   html += "function afterSavedReflectCurrent(){ for(var i=0;i<8;i++){ ACTMIN[i]=parseInt(document.getElementById('min_'+i).value,10); ACTMAX[i]=parseInt(document.getElementById('max_'+i).value,10); setActCell(i); touchedMin[i]=false; touchedMax[i]=false; lastChanged[i]=''; } }";
   html += "function refreshPads(){ fetch('/pad',{cache:'no-store'}).then(function(r){return r.text();}).then(function(t){ var v=t.trim().split(','); for(var i=0;i<8;i++){ PAD[i]=parseInt(v[i]||'0',10); setPadCell(i);} setTimeout(refreshPads,200); }).catch(function(){ setTimeout(refreshPads,1000); }); }";
-  html += "function sendValues(){ var d=collectCSV(); var msg=document.getElementById('msg'); msg.textContent='Envoi...'; fetch('/apply?min='+encodeURIComponent(d.min)+'&max='+encodeURIComponent(d.max),{cache:'no-store'}).then(function(r){if(!r.ok) throw new Error('bad'); return r.text();}).then(function(){ msg.textContent='Valeurs enregistr\u00E9es.'; afterSavedReflectCurrent(); setTimeout(function(){msg.textContent='';},1500); }).catch(function(){ msg.textContent='Erreur d’envoi'; }); }";
+  html += "function sendValues(){ var d=collectCSV(); var msg=document.getElementById('msg'); msg.textContent='Envoi...'; fetch('/apply?prof='+PROF+'&min='+encodeURIComponent(d.min)+'&max='+encodeURIComponent(d.max),{cache:'no-store'}).then(ackWait).then(function(){ msg.textContent='Valeurs enregistr\u00E9es.'; afterSavedReflectCurrent(); setTimeout(function(){msg.textContent='';},1500); }).catch(function(){ msg.textContent='Erreur d’envoi'; }); }";
   html += "function resetDefaults(){ for(var i=0;i<8;i++){ document.getElementById('min_'+i).value=255; document.getElementById('max_'+i).value=768; recalcRow(i);} sendValues(); }";
   html += "function finishBridage(){ var msg=document.getElementById('msg'); fetch('/finish',{cache:'no-store'}).then(function(){ msg.textContent='Bridage termin\u00E9.'; setTimeout(function(){ document.body.innerHTML='<div class=\"wrap\"><h3>Bridage termin\u00E9</h3><p>Vous pouvez fermer cette page.</p></div>'; },400); }).catch(function(){ msg.textContent='Erreur'; }); }";
 
-  html += "draw(); refreshPads();";
+  html += "function numIn(id,v){ return '<input type=\"number\" min=\"0\" max=\"10000\" step=\"10\" style=\"width:90px\" id=\"'+id+'\" value=\"'+v+'\">'; }";
+  html += "function crvSel(i){ var o=''; for(var c=0;c<CRVN.length;c++){ o+='<option value=\"'+c+'\"'+(c===CRV[i]?' selected':'')+'>'+CRVN[c]+'</option>'; } return '<select id=\"cv_'+i+'\">'+o+'</select>'; }";
+  html += "function prmIn(i){ var p=CRVP[i]; return '<input type=\"number\" min=\"0\" max=\"100\" style=\"width:60px\" id=\"ex_'+i+'\" value=\"'+p[0]+'\"> <input type=\"text\" style=\"width:90px\" id=\"kn_'+i+'\" value=\"'+p[1]+':'+p[2]+' '+p[3]+':'+p[4]+'\">'; }";
+  html += "function drawRamp(){ var t=''; for(var i=0;i<8;i++){ t+='<tr><td>'+AX[i]+'</td><td>'+numIn('ru_'+i,RUP[i])+'</td><td>'+numIn('rd_'+i,RDN[i])+'</td><td>'+crvSel(i)+'</td><td>'+prmIn(i)+'</td></tr>'; } document.getElementById('rb').innerHTML=t; document.getElementById('btnRamp').onclick=sendRamp; }";
+  html += "function sendRamp(){ var u=[],d=[],c=[],e=[],k=[]; for(var i=0;i<8;i++){ u.push(document.getElementById('ru_'+i).value||0); d.push(document.getElementById('rd_'+i).value||0); c.push(document.getElementById('cv_'+i).value); e.push(document.getElementById('ex_'+i).value||0); var kv=document.getElementById('kn_'+i).value.split(/[^0-9]+/).filter(function(x){return x!=='';}); for(var j=0;j<4;j++) k.push(kv[j]||0);} var m=document.getElementById('rmsg'); m.textContent='Envoi...'; fetch('/ramp?up='+u.join(',')+'&down='+d.join(',')+'&curve='+c.join(',')+'&expo='+e.join(',')+'&knee='+k.join(','),{cache:'no-store'}).then(ackWait).then(function(){ m.textContent='Rampes enregistr\u00E9es.'; setTimeout(function(){m.textContent='';},1500); }).catch(function(){ m.textContent='Erreur d’envoi'; }); }";
+  html += "draw(); drawRamp(); refreshPads();";
   html += "buildOffset(); document.getElementById('off').addEventListener('change',function(){applyOffset(false);}); document.getElementById('saveOff').addEventListener('click',function(){applyOffset(true);});";
   html += "</script></div></body></html>";
   return html;
 }
 
+String bridagePadCsv(){
+  int vals[AX_COUNT];
+  getPadValues(vals);
+  String s="";
+  for(int i=0;i<AX_COUNT;i++){ if(i) s+=","; s+=String(vals[i]); }
+  return s;
+}
+
 static bool bActive=false;
 static bool bStopPending=false;
 static uint32_t bStopAtMs=0;
@@ -176,10 +256,10 @@ void bridageStartAP(){
 
   // sécurité: forcer GPIO27 LOW pendant bridage
   pinMode(GPIO_MANETTE_CONNECTEE, OUTPUT);
-  digitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
+  halDigitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
 
   portalStart("ESP32-CONTROLE");
-  Serial.println("[BRIDAGE] D\u00E9marrage AP + page /bridage");
+  LOGI(LT_BRIDAGE, "D\u00E9marrage AP + page /bridage");
   auto& server = portalServer();
   server.on("/bridage", HTTP_GET, [&](){ server.send(200,"text/html",htmlPage()); });
   server.on("/apply", HTTP_GET, [&](){
@@ -195,49 +275,72 @@ void bridageStartAP(){
     int mins[AX_COUNT], maxs[AX_COUNT];
     parseCSV8(server.arg("min"), mins);
     parseCSV8(server.arg("max"), maxs);
-    int delta = neutralOffset - 512;
+    Cmd c{}; c.type = CMD_PAD_LIMITS;
+    c.limits.profile = server.hasArg("prof")? (uint8_t)clampInt(server.arg("prof").toInt(), 0, BRIDAGE_PROFILES-1) : bridageProfile;
     for(int i=0;i<AX_COUNT;i++){
       int mn = clampInt(mins[i], 0, 1023);
       int mx = clampInt(maxs[i], 0, 1023);
       if(mx < mn){ int t=mn; mn=mx; mx=t; }
-      padMapMin[i]=clampInt(mn + delta, 0, 1023);
-      padMapMax[i]=clampInt(mx + delta, 0, 1023);
-      bridageRecalcNeutralForAxis(i);
+      c.limits.mn[i]=(int16_t)mn; c.limits.mx[i]=(int16_t)mx;
     }
-    bridageSaveToEEPROM();
-    server.send(200,"text/plain","OK");
+    cmdRespond(server, cmdPost(c));
+  });
+  server.on("/ramp", HTTP_GET, [&](){
+    if(!server.hasArg("up") || !server.hasArg("down")){ server.send(400,"text/plain","missing args"); return; }
+    auto parseU16=[&](const String& s, uint16_t* out, int n=AX_COUNT){
+      int idx=0, from=0;
+      while(idx<n){
+        int comma=s.indexOf(',', from);
+        String tok = (comma<0)? s.substring(from) : s.substring(from, comma);
+        out[idx++] = (uint16_t)clampInt(tok.toInt(), 0, 10000);
+        if(comma<0) break;
+        from=comma+1;
+      }
+      while(idx<n) out[idx++]=0;
+    };
+    Cmd c{}; c.type = CMD_RAMP_CURVE;
+    parseU16(server.arg("up"), c.ramp.up);
+    parseU16(server.arg("down"), c.ramp.down);
+    c.ramp.hasCurve = server.hasArg("curve");
+    if(c.ramp.hasCurve){
+      uint16_t cv[AX_COUNT]; parseU16(server.arg("curve"), cv);
+      for(int i=0;i<AX_COUNT;i++) c.ramp.curve[i] = (cv[i]<CURVE_COUNT)? (uint8_t)cv[i] : CURVE_LINEAR;
+      // Réglages absents : ceux en cours ; bornés à 0..100 %, remis en ordre par curveCompile()
+      uint16_t ex[AX_COUNT], kn[AX_COUNT*4];
+      if(server.hasArg("expo")) parseU16(server.arg("expo"), ex);
+      if(server.hasArg("knee")) parseU16(server.arg("knee"), kn, AX_COUNT*4);
+      for(int i=0;i<AX_COUNT;i++){
+        CurveParam& p = c.ramp.param[i]; p = curveParam[i];
+        if(server.hasArg("expo")) p.expo = (uint8_t)clampInt(ex[i], 0, 100);
+        if(server.hasArg("knee")){ p.x1=(uint8_t)clampInt(kn[4*i],0,100); p.y1=(uint8_t)clampInt(kn[4*i+1],0,100); p.x2=(uint8_t)clampInt(kn[4*i+2],0,100); p.y2=(uint8_t)clampInt(kn[4*i+3],0,100); }
+      }
+    }
+    cmdRespond(server, cmdPost(c));
   });
   server.on("/finish", HTTP_GET, [&](){
     server.send(200,"text/plain","OK");
-    bStopPending=true; bStopAtMs=millis()+800;
+    bStopPending=true; bStopAtMs=halMillis()+800;
   });
   server.on("/offset", HTTP_GET, [&](){
     if(!server.hasArg("val")){ server.send(400,"text/plain","missing"); return; }
-    int v = clampInt(server.arg("val").toInt(), 0, 1023);
-    neutralOffset = v;
-    updateNeutralWindow();
-    if(server.hasArg("save")) { saveNeutralOffset(); bridageSaveToEEPROM(); }
-    server.send(200,"text/plain","OK");
+    Cmd c{}; c.type = CMD_NEUTRAL_OFFSET;
+    c.offset.val = (int16_t)clampInt(server.arg("val").toInt(), 0, 1023);
+    c.offset.save = server.hasArg("save");
+    cmdRespond(server, cmdPost(c));
   });
 
-  server.on("/pad", HTTP_GET, [&](){
-    int vals[AX_COUNT];
-    getPadValues(vals);
-    String s="";
-    for(int i=0;i<AX_COUNT;i++){ if(i) s+=","; s+=String(vals[i]); }
-    server.send(200,"text/plain",s);
-  });
+  server.on("/pad", HTTP_GET, [&](){ server.send(200,"text/plain",bridagePadCsv()); });
 
   bActive=true;
-  Serial.println("[BRIDAGE] Routes bridage montées (portail unique).");
+  LOGI(LT_BRIDAGE, "Routes bridage montées (portail unique).");
 }
 
-void bridageStopAP(){ bActive=false; portalStop(); Serial.println("[BRIDAGE] Inactif."); }
+void bridageStopAP(){ bActive=false; portalStop(); LOGI(LT_BRIDAGE, "Inactif."); }
 bool isBridageActive(){ return bActive; }
 
 void bridageHandlePortal(){
   portalHandle();
-  if(bStopPending && millis()>=bStopAtMs){
+  if(bStopPending && halMillis()>=bStopAtMs){
     bStopPending=false;
     bridageStopAP();
   }
@@ -253,14 +356,14 @@ void bridageHandleButtonSequence(bool /*unused*/, uint32_t /*shortPressMinMs*/,
 
   if(!isPadMode()){ last=false; tPress=0; count=0; windowStart=0; return; }
 
-  if(now && !last){ tPress = millis(); if(count==0) windowStart = tPress; }
+  if(now && !last){ tPress = halMillis(); if(count==0) windowStart = tPress; }
   if(!now && last){
-    uint32_t dt = millis() - tPress;
+    uint32_t dt = halMillis() - tPress;
     if(dt >= 50 && dt <= 800){
-      count++; Serial.printf("[BRIDAGE] Appui court %u/5\n", count);
+      count++; LOGI(LT_BRIDAGE, "Appui court %u/5", count);
       if(count>=5){ bridageStartAP(); count=0; windowStart=0; }
     }
   }
-  if(windowStart && (millis()-windowStart > 6000)){ count=0; windowStart=0; }
+  if(windowStart && (halMillis()-windowStart > 6000)){ count=0; windowStart=0; }
   last = now;
 }
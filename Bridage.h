@@ -3,14 +3,13 @@
 #include <WebServer.h>
 #include <DNSServer.h>
 
-enum AxisIdx { AX_X=0, AX_Y, AX_Z, AX_LX, AX_LY, AX_LZ, AX_R1, AX_R2, AX_COUNT=8 };
+#include "Axes.h"
 
-extern int padMapMin[AX_COUNT];
-extern int padMapMax[AX_COUNT];
-
-extern int padNeutral[AX_COUNT];
-extern int padNeutralMin[AX_COUNT];
-extern int padNeutralMax[AX_COUNT];
+// Bornes manette saisies (au neutre 512), une ligne par profil (BRIDAGE_PROFILES) ;
+// valeurs effectives et neutres : effCfg().padProf, profil actif : effCfg().pad
+extern int padMapMin[BRIDAGE_PROFILES][AX_COUNT];
+extern int padMapMax[BRIDAGE_PROFILES][AX_COUNT];
+extern uint8_t bridageProfile;   // profil actif, édité par la page /bridage ; 0 au démarrage
 
 bool isBridageActive();
 void bridageStartAP();
@@ -18,7 +17,13 @@ void bridageStopAP();
 void bridageHandlePortal();
 void bridageHandleButtonSequence(bool btnPressed, uint32_t shortPressMinMs=50, uint32_t longPressMs=5000);
 
-void bridageRecalcNeutralForAxis(int i);
+// Appliqués par la boucle de contrôle (CmdQueue.h), jamais depuis une route HTTP
+void bridageApplyLimits(uint8_t profile, const int16_t mn[AX_COUNT], const int16_t mx[AX_COUNT]);
+bool bridageSelectProfile(uint8_t p);   // manette : instantané précalculé, sans EEPROM ; false si p invalide
+const char* bridageProfileName(uint8_t p);
+struct CurveParam;
+void bridageApplyRamps(const uint16_t up[AX_COUNT], const uint16_t down[AX_COUNT], const uint8_t* curve, const CurveParam* param);   // curve nullptr = inchangées
 void bridageClampAndRecommend(int &minV, int &maxV, int changed);
-void bridageLoadOrDefault();
+void bridageLoadOrDefault();     // tous les profils, profil actif 0 ; après loadNeutralOffset() (migration EEPROM < 0x0004) ; puis effCfgRebuild()
 void bridageSaveToEEPROM();
+String bridagePadCsv();   // corps de /pad
@@ -4,10 +4,36 @@
 #include "Faults.h"
 #include "Portal.h"   // portail unique (optionnel pour la calib)
 #include "Bridage.h"
+#include "Log.h"
+#include "CmdQueue.h"
+#include "Trace.h"
 
 // ======================== États & constantes ========================
-bool haveMin[8]={false,false,false,false,false,false,false,false};
-bool haveMax[8]={false,false,false,false,false,false,false,false};
+bool haveMin[AX_COUNT]={};
+bool haveMax[AX_COUNT]={};
+uint8_t calNeutralHalf[AX_COUNT];
+
+// Statistiques glissantes (Welford) de la phase neutre, en pas bruts
+struct NeutralStat { uint32_t n; float mean, m2; int16_t mn, mx; };
+static NeutralStat neutralStat[AX_COUNT];
+
+static inline void welfordAdd(NeutralStat& s, int16_t v){
+  s.n++;
+  float d = (float)v - s.mean;
+  s.mean += d / (float)s.n;
+  s.m2   += d * ((float)v - s.mean);
+  if(s.n==1 || v<s.mn) s.mn=v;
+  if(s.n==1 || v>s.mx) s.mx=v;
+}
+static inline float welfordSigma(const NeutralStat& s){ return (s.n>1)? sqrtf(s.m2 / (float)(s.n-1)) : 0.0f; }
+
+// Balayage : extrêmes bruts vus par axe + ancre (extrême et instant où il a
+// dépassé la précédente de plus de GROW_RAW) : un levier poussé lentement ne
+// paraît donc pas stable. prev = échantillon précédent : un extrême doit tenir
+// 2 lectures (pas de pic isolé). sweepFollow : suivi maintenu en phase FINISH.
+struct SweepAxis { int16_t lo, hi, prev, aLo, aHi; uint32_t tLo, tHi; };
+static SweepAxis sweep[AX_COUNT];
+static bool sweepFollow = false;
 
 bool calibMode=false, wiredNeutralOK=false;
 
@@ -31,19 +57,17 @@ static const uint16_t NEUTRAL_AVG_MS      = 1000; // 1s de moyenne
 static const uint16_t NEUTRAL_VALIDATE_MS = 800;  // 0.8s de stabilité
 static const uint16_t READY_HOLD_MS       = 2000; // LED verte fixe avant relâche
 
-// Fenêtre neutre finale (provenant d'IOMap.cpp)
-extern int joyNeutralMin, joyNeutralMax;
-
 // ======================== EEPROM ========================
 #define EE_MAGIC 0xC0DE
-#define EE_VER   0x0002
+#define EE_VER   0x0003   // 0x0003 : + demi-fenêtre neutre par axe
 #define EE_MAGIC_ADDR 0
 #define EE_VER_ADDR   2
 #define EE_DATA_ADDR  4
 
 static void setDefaultCal(){
-  for(int i=0;i<8;i++){
+  for(int i=0;i<AX_COUNT;i++){
     cal[i].minV=0; cal[i].midV=16384; cal[i].maxV=32767;
+    calNeutralHalf[i]=JOY_NEUTRAL_HALF_WINDOW;
     haveMin[i]=haveMax[i]=false;
   }
   calDataValid = false;
@@ -57,16 +81,21 @@ static bool loadCalFromEEPROM(){
   EEPROM.get(EE_MAGIC_ADDR,magic);
   EEPROM.get(EE_VER_ADDR,ver);
   if(magic!=EE_MAGIC){
-    Serial.println("[CAL] EEPROM invalide -> valeurs par défaut.");
+    LOGW(LT_CAL, "EEPROM invalide -> valeurs par défaut.");
     return false;
   }
   int addr=EE_DATA_ADDR;
-  for(int i=0;i<8;i++){
+  for(int i=0;i<AX_COUNT;i++){
     EEPROM.get(addr,cal[i].minV); addr+=2;
     EEPROM.get(addr,cal[i].midV); addr+=2;
     EEPROM.get(addr,cal[i].maxV); addr+=2;
   }
-  Serial.printf("[CAL] Chargement OK (ver 0x%04X).\n", ver);
+  for(int i=0;i<AX_COUNT;i++){
+    uint8_t h=JOY_NEUTRAL_HALF_WINDOW;
+    if(ver>=0x0003){ EEPROM.get(addr,h); addr+=1; }
+    calNeutralHalf[i] = (h>=CAL_NEUTRAL_MIN_HALF && h<=CAL_NEUTRAL_MAX_HALF)? h : JOY_NEUTRAL_HALF_WINDOW;
+  }
+  LOGI(LT_CAL, "Chargement OK (ver 0x%04X).", ver);
   return true;
 }
 
@@ -82,16 +111,17 @@ void saveCalToEEPROM(){
   EEPROM.put(EE_MAGIC_ADDR,(uint16_t)EE_MAGIC);
   EEPROM.put(EE_VER_ADDR,(uint16_t)EE_VER);
   int addr=EE_DATA_ADDR;
-  for(int i=0;i<8;i++){
+  for(int i=0;i<AX_COUNT;i++){
     EEPROM.put(addr,cal[i].minV); addr+=2;
     EEPROM.put(addr,cal[i].midV); addr+=2;
     EEPROM.put(addr,cal[i].maxV); addr+=2;
   }
+  for(int i=0;i<AX_COUNT;i++){ EEPROM.put(addr,calNeutralHalf[i]); addr+=1; }
 #if defined(ARDUINO_ARCH_ESP32)
-  EEPROM.commit();
+  { TRACE_SCOPE(TR_FLASH); EEPROM.commit(); }
 #endif
   calDataValid = true;
-  Serial.println("[CAL] Sauvegarde OK.");
+  LOGI(LT_CAL, "Sauvegarde OK.");
 }
 
 // ======================== Helpers mapping & bouton ========================
@@ -107,9 +137,9 @@ static inline int mapRawPreCal(int16_t raw){
 
 // Détection axe le plus écarté du neutre (en MAP pré-calibration)
 static int detectMovedAxisMAP(const ADSRaw& r, int16_t thr_map){
-  int16_t raw[8]={r.X,r.Y,r.Z,r.LX,r.LY,r.LZ,r.R1,r.R2};
+  const int16_t* raw = r.v;
   int idx=-1; long best=0;
-  for(int i=0;i<8;i++){
+  for(int i=0;i<AX_COUNT;i++){
     int mid_map = mapRawPreCal(cal[i].midV);
     int v_map   = mapRawPreCal(raw[i]);
     long d = labs((long)v_map - (long)mid_map);
@@ -118,8 +148,55 @@ static int detectMovedAxisMAP(const ADSRaw& r, int16_t thr_map){
   return (best<thr_map)?-1:idx;
 }
 
+static void sweepReset(){
+  uint32_t now = halMillis();
+  for(int i=0;i<AX_COUNT;i++){ int16_t m = cal[i].midV; sweep[i] = { m, m, m, m, m, now, now }; }
+}
+
+// Course exigée d'un côté (MAP pré‑calibration) : MIN_TRAVEL_PCT de la demi‑course
+// estimée depuis le neutre (0 → midV, midV → 2·midV borné à la pleine échelle).
+static int sweepTravelLo(int i){ int m = mapRawPreCal(cal[i].midV); return (m - mapRawPreCal(0)) * CAL_SWEEP_MIN_TRAVEL_PCT / 100; }
+static int sweepTravelHi(int i){
+  int m = mapRawPreCal(cal[i].midV);
+  return (mapRawPreCal((int16_t)min(2L * cal[i].midV, 32767L)) - m) * CAL_SWEEP_MIN_TRAVEL_PCT / 100;
+}
+
+// Une lecture de balayage ; retourne true quand tous les extrêmes sont acquis
+static bool sweepUpdate(const ADSRaw& r){
+  uint32_t now = halMillis();
+  bool done = true, changed = false;
+  for(int i=0;i<AX_COUNT;i++){
+    SweepAxis& s = sweep[i];
+    int16_t v = r.v[i];
+    int16_t lo = max(v, s.prev), hi = min(v, s.prev);
+    s.prev = v;
+    if(lo < s.lo) s.lo = lo;
+    if(hi > s.hi) s.hi = hi;
+    if(s.aLo - s.lo > CAL_SWEEP_GROW_RAW){ s.aLo = s.lo; s.tLo = now; }
+    if(s.hi - s.aHi > CAL_SWEEP_GROW_RAW){ s.aHi = s.hi; s.tHi = now; }
+
+    int mid_map = mapRawPreCal(cal[i].midV);
+    bool loOk = (mid_map - mapRawPreCal(s.lo) >= sweepTravelLo(i)) && (now - s.tLo >= CAL_SWEEP_STABLE_MS);
+    bool hiOk = (mapRawPreCal(s.hi) - mid_map >= sweepTravelHi(i)) && (now - s.tHi >= CAL_SWEEP_STABLE_MS);
+
+    // Une fois acquis, l'extrême suit encore les progressions (butée un peu plus loin),
+    // y compris en phase FINISH tant que le levier n'est pas revenu au neutre
+    if(loOk || haveMin[i]){
+      if(!haveMin[i]){ LOGI(LT_CAL, "Axe %d : MIN acquis (brut %d)", i, s.lo); pulseGreen2(); }
+      changed |= (cal[i].minV != s.lo); cal[i].minV = s.lo; haveMin[i] = true;
+    }
+    if(hiOk || haveMax[i]){
+      if(!haveMax[i]){ LOGI(LT_CAL, "Axe %d : MAX acquis (brut %d)", i, s.hi); pulseGreen2(); }
+      changed |= (cal[i].maxV != s.hi); cal[i].maxV = s.hi; haveMax[i] = true;
+    }
+    if(!haveMin[i] || !haveMax[i]) done = false;
+  }
+  if(changed) effCfgRebuild();
+  return done;
+}
+
 // Bouton calibration (dans ce projet : HIGH = appui)
-bool readCalButton(){ return digitalRead(CAL_BTN_PIN)==HIGH; }
+bool readCalButton(){ return halDigitalRead(CAL_BTN_PIN)==HIGH; }
 
 // ======================== Portail web (optionnel) ========================
 static String navBar(){
@@ -135,6 +212,31 @@ static String navBar(){
   );
 }
 
+// JSON de /axes.json (MAP courants + extrêmes enregistrés)
+String calAxesJson(){
+  const ADSRaw& r = adsDiagRaw();   // pas d'accès bus depuis le portail
+  Axes8 m = mapADSAll(r);
+  const int* val = m.v;
+
+  String json = "{\"cur\":[";
+  for(int i=0;i<AX_COUNT;i++){ json += String(val[i]); if(i<AX_COUNT-1) json+=','; }
+  // En balayage : extrêmes vus en direct (acquis ou non)
+  bool sw = (calPhase == CAL_PHASE_SWEEP);
+  json += "],\"min_map\":[";
+  for(int i=0;i<AX_COUNT;i++){ json += String(mapRawPreCal(sw? sweep[i].lo : cal[i].minV)); if(i<AX_COUNT-1) json+=','; }
+  json += "],\"max_map\":[";
+  for(int i=0;i<AX_COUNT;i++){ json += String(mapRawPreCal(sw? sweep[i].hi : cal[i].maxV)); if(i<AX_COUNT-1) json+=','; }
+  json += "],\"saved\":[";
+  for(int i=0;i<AX_COUNT;i++){ json += (haveMin[i] && haveMax[i]) ? "true" : "false"; if(i<AX_COUNT-1) json+=','; }
+  json += "],\"smin\":[";
+  for(int i=0;i<AX_COUNT;i++){ json += haveMin[i] ? "true" : "false"; if(i<AX_COUNT-1) json+=','; }
+  json += "],\"smax\":[";
+  for(int i=0;i<AX_COUNT;i++){ json += haveMax[i] ? "true" : "false"; if(i<AX_COUNT-1) json+=','; }
+  json += "],\"sweep\":"; json += sw ? "true" : "false";
+  json += "}";
+  return json;
+}
+
 void calibWifiStart(){
   portalStart("ESP32-CONTROLE");
   auto& server = portalServer();
@@ -152,45 +254,32 @@ void calibWifiStart(){
       "</style></head><body>"
       "<h2>Calibration (mode filaire)</h2>" + navBar() +
       "<p class='muted'>Suivi d\u00E9taill\u00E9 dans le Moniteur s\u00E9rie (MAP). Min/Max s’affichent quand enregistr\u00E9s.</p>"
-      "<table><thead><tr><th>Axe</th><th>Actuel MAP</th><th>Min MAP</th><th>Max MAP</th><th>Enregistr\u00E9</th></tr></thead>"
+      "<p id='mode' class='muted'></p>"
+      "<table><thead><tr><th>Axe</th><th>Actuel MAP</th><th>Min MAP</th><th>Max MAP</th><th>Couverture</th><th>Enregistr\u00E9</th></tr></thead>"
       "<tbody id='rows'></tbody></table>"
-      "<script>"
+      "<script>" + String(portalAckJs()) +
       "const AX=['X','Y','Z','LX','LY','LZ','R1','R2'];"
       "const OFFSET=" + String(neutralOffset) + ";"
-      "(function(){let sel=document.createElement('select');sel.id='off';for(let v=0;v<=1023;v++){let o=document.createElement('option');o.value=v;o.text=v;if(v===OFFSET)o.selected=true;sel.appendChild(o);}let btn=document.createElement('button');btn.id='saveOff';btn.textContent='Sauvegarde EEPROM';let div=document.createElement('div');div.style.margin='10px 0';div.appendChild(document.createTextNode('D\u00E9calage neutre : '));div.appendChild(sel);div.appendChild(document.createTextNode(' '));div.appendChild(btn);let tbl=document.querySelector('table');document.body.insertBefore(div,tbl);sel.addEventListener('change',()=>fetch('/offset?val='+sel.value,{cache:'no-store'}));btn.addEventListener('click',()=>fetch('/offset?val='+sel.value+'&save=1',{cache:'no-store'}).then(()=>alert('Offset sauvegard\u00E9')));})();"
-      "function r(j){let t='';for(let i=0;i<8;i++){const s=!!j.saved[i];"
-      "t+=`<tr><td>${AX[i]}</td><td>${Number(j.cur[i])}</td><td>${Number(j.min_map[i])}</td><td>${Number(j.max_map[i])}</td><td class='${s?'ok':'bad'}'>${s?'\\u2713':'\\u2717'}</td></tr>`;}"
-      "document.getElementById('rows').innerHTML=t;}"
+      "(function(){let sel=document.createElement('select');sel.id='off';for(let v=0;v<=1023;v++){let o=document.createElement('option');o.value=v;o.text=v;if(v===OFFSET)o.selected=true;sel.appendChild(o);}let btn=document.createElement('button');btn.id='saveOff';btn.textContent='Sauvegarde EEPROM';let div=document.createElement('div');div.style.margin='10px 0';div.appendChild(document.createTextNode('D\u00E9calage neutre : '));div.appendChild(sel);div.appendChild(document.createTextNode(' '));div.appendChild(btn);let tbl=document.querySelector('table');document.body.insertBefore(div,tbl);sel.addEventListener('change',()=>fetch('/offset?val='+sel.value,{cache:'no-store'}).then(ackWait));btn.addEventListener('click',()=>fetch('/offset?val='+sel.value+'&save=1',{cache:'no-store'}).then(ackWait).then(()=>alert('Offset sauvegard\u00E9'),()=>alert('Erreur')));})();"
+      "function c(a,b){return `<span class='${a?'ok':'muted'}'>${a?'\\u25C0':'\\u25C1'}</span> <span class='${b?'ok':'muted'}'>${b?'\\u25B6':'\\u25B7'}</span>`;}"
+      "function r(j){let t='';for(let i=0;i<j.cur.length;i++){const s=!!j.saved[i];"
+      "const cov=Math.max(0,Math.round((j.max_map[i]-j.min_map[i])*100/513));"
+      "t+=`<tr><td>${AX[i]}</td><td>${Number(j.cur[i])}</td><td>${Number(j.min_map[i])}</td><td>${Number(j.max_map[i])}</td><td>${cov}% ${c(j.smin[i],j.smax[i])}</td><td class='${s?'ok':'bad'}'>${s?'\\u2713':'\\u2717'}</td></tr>`;}"
+      "document.getElementById('rows').innerHTML=t;"
+      "document.getElementById('mode').textContent=j.sweep?'Balayage : amener chaque levier en but\\u00E9e des deux c\\u00F4t\\u00E9s et l\\u2019y tenir (appui court = mode appui par appui).':'';}"
       "async function p(){try{let x=await fetch('/axes.json',{cache:'no-store'});r(await x.json())}catch(e){}setTimeout(p,800);}p();"
       "</script></body></html>";
     server.send(200,"text/html",html);
   });
 
-    server.on("/axes.json", HTTP_GET, [&](){
-      ADSRaw r = readADSRaw();
-      Axes8 m = mapADSAll(r);
-      int* val = (int*)&m;
-
-      String json = "{\"cur\":[";
-      for(int i=0;i<8;i++){ json += String(val[i]); if(i<7) json+=','; }
-      json += "],\"min_map\":[";
-      for(int i=0;i<8;i++){ json += String(mapRawPreCal(cal[i].minV)); if(i<7) json+=','; }
-      json += "],\"max_map\":[";
-      for(int i=0;i<8;i++){ json += String(mapRawPreCal(cal[i].maxV)); if(i<7) json+=','; }
-      json += "],\"saved\":[";
-      for(int i=0;i<8;i++){ json += (haveMin[i] && haveMax[i]) ? "true" : "false"; if(i<7) json+=','; }
-      json += "]}";
-      server.send(200, "application/json", json);
-
-    });
+    server.on("/axes.json", HTTP_GET, [&](){ server.send(200, "application/json", calAxesJson()); });
 
   server.on("/offset", HTTP_GET, [&](){
     if(!server.hasArg("val")){ server.send(400,"text/plain","missing"); return; }
-    int v = constrain(server.arg("val").toInt(), 0, 1023);
-    neutralOffset = v;
-    updateNeutralWindow();
-    if(server.hasArg("save")) { saveNeutralOffset(); bridageSaveToEEPROM(); }
-    server.send(200,"text/plain","OK");
+    Cmd c{}; c.type = CMD_NEUTRAL_OFFSET;
+    c.offset.val = (int16_t)constrain(server.arg("val").toInt(), 0, 1023);
+    c.offset.save = server.hasArg("save");
+    cmdRespond(server, cmdPost(c));
   });
 }
 
@@ -202,33 +291,61 @@ void startCalibration(){
   calibMode=true;
 
   setDefaultCal();
+  effCfgRebuild();
+  sweepFollow = false;
   calPhase = CAL_PHASE_NEUTRAL_INIT;
-  calPhaseEndMs = millis() + NEUTRAL_AVG_MS;
+  calPhaseEndMs = halMillis() + NEUTRAL_AVG_MS;
   stopBlink();
   startBlink(LEDP_GREEN, 0xFFFFFFFF, 700); // clignotement lent phase neutre
   neutralizeAllOutputs();
 
   // Sécurité : forcer GPIO27 LOW pendant toute la calibration
   pinMode(GPIO_MANETTE_CONNECTEE, OUTPUT);
-  digitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
+  halDigitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
 
   calibWifiStart();
-  Serial.println("=== CALIBRATION DEMARREE ===");
+  LOGI(LT_CAL, "=== CALIBRATION DEMARREE ===");
+}
+
+// Demi-fenêtre neutre d'un axe à partir du bruit de la phase neutre.
+// Conversion brut → MAP sur le côté le plus court (le plus de points par pas brut).
+static uint8_t neutralHalfFromNoise(int i){
+  const NeutralStat& s = neutralStat[i];
+  if(s.n<2) return JOY_NEUTRAL_HALF_WINDOW;
+  int span = min(cal[i].midV - cal[i].minV, cal[i].maxV - cal[i].midV); if(span<1) span=1;
+  float k = 256.0f / (float)span;
+  float noiseRaw = max((float)CAL_NEUTRAL_SIGMA_K * welfordSigma(s), (float)(s.mx - s.mn) * 0.5f);
+  int h = (int)ceilf(noiseRaw * k) + CAL_NEUTRAL_MARGIN;
+  return (uint8_t)constrain(h, CAL_NEUTRAL_MIN_HALF, CAL_NEUTRAL_MAX_HALF);
+}
+
+// En phase FINISH les butées peuvent encore bouger (balayage suivi) : fenêtres recalculées
+static void neutralHalfUpdate(){
+  bool changed = false;
+  for(int i=0;i<AX_COUNT;i++){ uint8_t h = neutralHalfFromNoise(i); changed |= (h != calNeutralHalf[i]); calNeutralHalf[i] = h; }
+  if(changed) effCfgRebuild();
 }
 
 void finishCalibration(){
   // Sanity check sur min/mid/max
-  for(int i=0;i<8;i++){
+  for(int i=0;i<AX_COUNT;i++){
     if(cal[i].minV>=cal[i].midV) cal[i].minV=cal[i].midV-1;
     if(cal[i].maxV<=cal[i].midV) cal[i].maxV=cal[i].midV+1;
   }
+  for(int i=0;i<AX_COUNT;i++){
+    calNeutralHalf[i] = neutralHalfFromNoise(i);
+    LOGI(LT_CAL, "Axe %d : sigma=%.1f crête=%d (brut) -> neutre ±%u", i, welfordSigma(neutralStat[i]),
+         neutralStat[i].mx - neutralStat[i].mn, calNeutralHalf[i]);
+  }
   saveCalToEEPROM();
+  effCfgRebuild();
+  sweepFollow = false;
   calibWifiStop();
   calibMode=false;
   calPhase = CAL_PHASE_IDLE;
   stopBlink();
   setLED(true,false);
-  Serial.println("=== CALIBRATION TERMINEE ===");
+  LOGI(LT_CAL, "=== CALIBRATION TERMINEE ===");
 }
 
 // ======================== Boucle Calibration (FSM) ========================
@@ -237,7 +354,7 @@ void processCalibration(){
 
   // Laisser vivre le portail (si ouvert) + sécurité
   portalHandle();
-  if (calibMode) digitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
+  if (calibMode) halDigitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
 
   // --- Pré-état : attente appui long + relâchement ---
   bool pressed = readCalButton();
@@ -246,12 +363,12 @@ void processCalibration(){
   if(!calibMode){
     switch(preState){
       case 0: // idle
-        if(pressed){ preState=1; preT0=millis(); startBlink(LEDP_ALT,0xFFFFFFFF,180); }
+        if(pressed){ preState=1; preT0=halMillis(); startBlink(LEDP_ALT,0xFFFFFFFF,180); }
         break;
       case 1: // holding
         if(!pressed){ preState=0; stopBlink(); setLED(false,false); }
-        else if(millis()-preT0>=CAL_HOLD_MS){
-          preState=2; solidGreenFor(READY_HOLD_MS); preReadyEnd=millis()+READY_HOLD_MS;
+        else if(halMillis()-preT0>=CAL_HOLD_MS){
+          preState=2; solidGreenFor(READY_HOLD_MS); preReadyEnd=halMillis()+READY_HOLD_MS;
         } else {
           serviceBlink();
         }
@@ -259,7 +376,7 @@ void processCalibration(){
       case 2: // ready, waiting release after 2s
         serviceBlink();
         if(!pressed){
-          if(millis()>=preReadyEnd){ stopBlink(); setLED(false,false); preState=0; startCalibration(); }
+          if(halMillis()>=preReadyEnd){ stopBlink(); setLED(false,false); preState=0; startCalibration(); }
           else { stopBlink(); setLED(false,false); preState=0; }
         }
         break;
@@ -269,42 +386,44 @@ void processCalibration(){
 
   // Affichage MAP uniquement (10 Hz) -- seulement PENDANT la calibration
   static uint32_t lastPrint=0;
-  if (calibMode && millis()-lastPrint >= 100){
-    ADSRaw r = readADSRaw();
-    Axes8 a = mapADSAll(r);
-    Serial.printf("[MAP] X=%3d Y=%3d Z=%3d LX=%3d LY=%3d LZ=%3d R1=%3d R2=%3d\n", a.X,a.Y,a.Z,a.LX,a.LY,a.LZ,a.R1,a.R2);
-    lastPrint = millis();
+  if (calibMode && halMillis()-lastPrint >= 100 && logEnabled(LT_MAP, LOG_INFO)){
+    Axes8 a = mapADSAll(adsLastRaw());   // scan de la machine d'états au tour précédent
+    LOGI(LT_MAP, "X=%3d Y=%3d Z=%3d LX=%3d LY=%3d LZ=%3d R1=%3d R2=%3d",
+         a.v[AX_X],a.v[AX_Y],a.v[AX_Z],a.v[AX_LX],a.v[AX_LY],a.v[AX_LZ],a.v[AX_R1],a.v[AX_R2]);
+    lastPrint = halMillis();
   }
 
   // Gestion bouton (détection appui court / long)
   pressed = readCalButton();
-  if(pressed && !calBtnLast){ calBtnStart=millis(); }
-  bool shortRelease = (!pressed && calBtnLast && (millis()-calBtnStart>=CAL_SHORT_MIN_MS) && (millis()-calBtnStart<CAL_HOLD_MS));
+  if(pressed && !calBtnLast){ calBtnStart=halMillis(); }
+  bool shortRelease = (!pressed && calBtnLast && (halMillis()-calBtnStart>=CAL_SHORT_MIN_MS) && (halMillis()-calBtnStart<CAL_HOLD_MS));
   calBtnLast=pressed;
 
   // FSM
   switch(calPhase){
 
     case CAL_PHASE_NEUTRAL_INIT: {
-      // Moyenne sur 1s pour fixer mid ~ neutre => 512 en MAP
-      static uint32_t t0=0; static long acc[8]={0}; static int n=0;
-      if(t0==0){ t0=millis(); for(int i=0;i<8;i++) acc[i]=0; n=0; }
+      // Moyenne/variance/min/max glissantes sur 1s : mid ~ neutre => 512 en MAP,
+      // le bruit fixera la fenêtre neutre de l'axe en fin de calibration
+      static uint32_t t0=0;
+      if(t0==0){ t0=halMillis(); memset(neutralStat, 0, sizeof(neutralStat)); }
 
-      ADSRaw rr=readADSRaw(); int16_t vv[8]={rr.X,rr.Y,rr.Z,rr.LX,rr.LY,rr.LZ,rr.R1,rr.R2};
-      for(int i=0;i<8;i++) acc[i]+=vv[i]; n++;
+      ADSRaw rr=readADSRaw();
+      axesForEach([&](auto ax){ constexpr uint8_t i = decltype(ax)::value; welfordAdd(neutralStat[i], rr.v[i]); });
 
       neutralizeAllOutputs();
 
-      if(millis() >= calPhaseEndMs){
-        for(int i=0;i<8;i++){
-          long m=acc[i]/n; cal[i].midV=(int16_t)constrain(m,0,32767);
+      if(halMillis() >= calPhaseEndMs){
+        for(int i=0;i<AX_COUNT;i++){
+          long m=lroundf(neutralStat[i].mean); cal[i].midV=(int16_t)constrain(m,0,32767);
           cal[i].minV=max(0,cal[i].midV-8000); cal[i].maxV=min(32767,cal[i].midV+8000);
           haveMin[i]=haveMax[i]=false;
         }
-        Serial.println("[CAL] neutres enregistrés !");
+        effCfgRebuild();
+        LOGI(LT_CAL, "neutres enregistrés !");
         t0=0;
         calPhase = CAL_PHASE_NEUTRAL_VALIDATE;
-        calPhaseEndMs = millis() + NEUTRAL_VALIDATE_MS;
+        calPhaseEndMs = halMillis() + NEUTRAL_VALIDATE_MS;
       }
       return;
     }
@@ -316,10 +435,10 @@ void processCalibration(){
 
       neutralizeAllOutputs();
 
-      if(millis() >= calPhaseEndMs && stable){
+      if(halMillis() >= calPhaseEndMs && stable){
         solidGreenFor(3000); // validation neutre
         calPhase = CAL_PHASE_NEUTRAL_DONE;
-        calPhaseEndMs = millis() + 3000;
+        calPhaseEndMs = halMillis() + 3000;
       }
       return;
     }
@@ -327,37 +446,69 @@ void processCalibration(){
     case CAL_PHASE_NEUTRAL_DONE: {
       serviceBlink();
       neutralizeAllOutputs();
-      if(millis() >= calPhaseEndMs){
+      if(halMillis() >= calPhaseEndMs){
+#if CAL_SWEEP_ENABLE
+        sweepReset();
+        startBlink(LEDP_BOTH, 0xFFFFFFFF, 200);  // passage balayage (vert+rouge)
+        calPhase = CAL_PHASE_SWEEP;
+        LOGI(LT_CAL, "Balayage : amener chaque levier en butée des deux côtés (appui court = appui par appui).");
+#else
         startBlink(LEDP_GREEN, 0xFFFFFFFF, 120); // passage phase extrêmes (clignotement rapide)
         calPhase = CAL_PHASE_EXTREMES;
+#endif
       }
       return;
     }
 
+    case CAL_PHASE_SWEEP: {
+      // Appui court -> repli sur le mode appui par appui (extrêmes acquis conservés)
+      if(shortRelease){
+        LOGI(LT_CAL, "Balayage interrompu -> mode appui par appui.");
+        startBlink(LEDP_GREEN, 0xFFFFFFFF, 120);
+        calPhase = CAL_PHASE_EXTREMES;
+        neutralizeAllOutputs();
+        return;
+      }
+
+      ADSRaw rr=readADSRaw();
+      if(sweepUpdate(rr)){
+        LOGI(LT_CAL, "Balayage complet : revenir au neutre.");
+        startBlink(LEDP_GREEN, 0xFFFFFFFF, 150);
+        sweepFollow = true;
+        calPhase = CAL_PHASE_FINISH;
+      } else {
+        serviceBlink();
+        if(!isBlinking()) startBlink(LEDP_BOTH, 0xFFFFFFFF, 200); // après pulseGreen2()
+      }
+
+      neutralizeAllOutputs();
+      return;
+    }
+
     case CAL_PHASE_EXTREMES: {
       // Appui court -> enregistre MIN ou MAX de l’axe le plus éloigné
       if(shortRelease){
         ADSRaw rr=readADSRaw();
         int ax = detectMovedAxisMAP(rr, CAL_MOVE_THR_MAP);
         if(ax<0){
-          Serial.println("[ERREUR] Mouvement insuffisant (< seuil 20).");
+          LOGW(LT_CAL, "Mouvement insuffisant (< seuil 20).");
           solidRedFor(1000);
         } else {
-          int16_t v_raw = ((int16_t*)&rr)[ax];
+          int16_t v_raw = rr.v[ax];
           int v_map   = mapRawPreCal(v_raw);
           int mid_map = mapRawPreCal(cal[ax].midV);
           bool isMin = (v_map < mid_map);
 
           if(isMin){ cal[ax].minV=v_raw; haveMin[ax]=true; }
           else     { cal[ax].maxV=v_raw; haveMax[ax]=true; }
+          effCfgRebuild();
 
           Axes8 aNow = mapADSAll(rr);
-          int v_mapped_arr[8]={aNow.X,aNow.Y,aNow.Z,aNow.LX,aNow.LY,aNow.LZ,aNow.R1,aNow.R2};
-          int v_mapped = v_mapped_arr[ax];
-          Serial.printf("[OK] Axe %d enregistré: %s = MAP %d\n", ax, isMin?"MIN":"MAX", v_mapped);
+          int v_mapped = aNow.v[ax];
+          LOGI(LT_CAL, "Axe %d enregistré: %s = MAP %d", ax, isMin?"MIN":"MAX", v_mapped);
           pulseGreen2();
 
-          bool done=true; for(int i=0;i<8;i++) if(!haveMin[i]||!haveMax[i]){done=false;break;}
+          bool done=true; for(int i=0;i<AX_COUNT;i++) if(!haveMin[i]||!haveMax[i]){done=false;break;}
           if(done){
             startBlink(LEDP_GREEN, 0xFFFFFFFF, 150);
             calPhase = CAL_PHASE_FINISH;
@@ -381,12 +532,15 @@ void processCalibration(){
     case CAL_PHASE_FINISH: {
       serviceBlink();
 
-      // ✅ Fin SEULEMENT si toutes les MAP sont dans la fenêtre [joyNeutralMin..joyNeutralMax]
+      // ✅ Fin SEULEMENT si chaque MAP est dans la fenêtre de son axe [joyNeutralMinAx..joyNeutralMaxAx]
+      // (issue du bruit de la phase neutre : un levier bruité n'empêche pas de conclure)
       ADSRaw rNow = readADSRaw();
-      Axes8 aNow  = mapADSAll(rNow);
-      int v[8]={aNow.X,aNow.Y,aNow.Z,aNow.LX,aNow.LY,aNow.LZ,aNow.R1,aNow.R2};
+      if(sweepFollow) sweepUpdate(rNow); // le dernier levier peut encore gagner sa butée
+      neutralHalfUpdate();
+      const EffectiveConfig& c = effCfg();
+      Axes8 aNow  = mapADSAll(rNow, c);
       bool neutral = true;
-      for(int i=0;i<8;i++){ if(v[i] < joyNeutralMin || v[i] > joyNeutralMax){ neutral=false; break; } }
+      for(int i=0;i<AX_COUNT;i++){ if(aNow.v[i] < c.joyNeutralMinAx[i] || aNow.v[i] > c.joyNeutralMaxAx[i]){ neutral=false; break; } }
 
       if(neutral){
         finishCalibration();
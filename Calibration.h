@@ -1,5 +1,6 @@
 #pragma once
 #include "Config.h"
+#include "Axes.h"
 #include <EEPROM.h>
 #include <WebServer.h>
 #include <WiFi.h>
@@ -7,8 +8,9 @@
 
 // -------- Types/extern --------
 struct CalAxis;
-extern CalAxis cal[8];
-extern bool haveMin[8], haveMax[8];
+extern CalAxis cal[AX_COUNT];
+extern bool haveMin[AX_COUNT], haveMax[AX_COUNT];
+extern uint8_t calNeutralHalf[AX_COUNT];   // demi-fenêtre neutre par axe (points MAP), sauvée avec la calibration
 
 extern bool calibMode;
 extern bool wiredNeutralOK;
@@ -22,8 +24,9 @@ enum CalPhase : uint8_t {
   CAL_PHASE_NEUTRAL_INIT,
   CAL_PHASE_NEUTRAL_VALIDATE,
   CAL_PHASE_NEUTRAL_DONE,
-  CAL_PHASE_EXTREMES,
-  CAL_PHASE_FINISH
+  CAL_PHASE_EXTREMES,   // appui court par extrême (repli)
+  CAL_PHASE_FINISH,
+  CAL_PHASE_SWEEP       // balayage simultané de tous les axes
 };
 extern volatile CalPhase calPhase;
 
@@ -45,3 +48,4 @@ void finishCalibration();
 // Portail (laissé actif, mais affichage série prioritaire)
 void calibWifiStart();
 void calibWifiStop();
+String calAxesJson();   // corps de /axes.json
@@ -0,0 +1,81 @@
+// CmdQueue.cpp — File de commandes portail → boucle de contrôle (SPSC, sans verrou)
+#include "CmdQueue.h"
+#include "Hal.h"
+#include "Bridage.h"
+#include "EffConfig.h"
+#include "Log.h"
+#include <atomic>
+
+static_assert((CMD_QUEUE_DEPTH & (CMD_QUEUE_DEPTH-1)) == 0, "CMD_QUEUE_DEPTH : puissance de 2");
+
+static Cmd ring[CMD_QUEUE_DEPTH];
+static std::atomic<uint32_t> head{0};      // écrit par le producteur
+static std::atomic<uint32_t> tail{0};      // écrit par le consommateur
+static std::atomic<uint32_t> applied{0};   // dernier n° appliqué (ordre FIFO => tous les précédents aussi)
+static uint32_t nextId = 1;                // producteur
+static uint32_t full = 0;                  // producteur
+
+// Latence mise en file → application (consommateur)
+struct CmdStat { uint32_t n; uint64_t sum; uint32_t mn, mx; };
+static CmdStat stat;
+
+uint32_t cmdPost(Cmd& c){
+  uint32_t h = head.load(std::memory_order_relaxed);
+  if(h - tail.load(std::memory_order_acquire) >= CMD_QUEUE_DEPTH){ full++; return 0; }
+  c.id = nextId++;
+  c.tEnqUs = halMicros();
+  ring[h & (CMD_QUEUE_DEPTH-1)] = c;
+  head.store(h+1, std::memory_order_release);
+  return c.id;
+}
+
+CmdAck cmdAckStatus(uint32_t id){
+  if(id == 0 || id >= nextId) return ACK_UNKNOWN;
+  return (int32_t)(applied.load(std::memory_order_acquire) - id) >= 0 ? ACK_DONE : ACK_PENDING;
+}
+
+void cmdRespond(WebServer& server, uint32_t id){
+  if(!id){ server.send(503,"text/plain","busy"); return; }
+  server.send(202,"text/plain",String((unsigned long)id));
+}
+
+static void apply(const Cmd& c){
+  switch(c.type){
+    case CMD_PAD_LIMITS:
+      bridageApplyLimits(c.limits.profile, c.limits.mn, c.limits.mx);
+      bridageSaveToEEPROM();
+      break;
+    case CMD_RAMP_CURVE:
+      bridageApplyRamps(c.ramp.up, c.ramp.down, c.ramp.hasCurve? c.ramp.curve : nullptr, c.ramp.param);
+      bridageSaveToEEPROM();
+      break;
+    case CMD_NEUTRAL_OFFSET:
+      neutralOffset = c.offset.val;
+      effCfgRebuild();
+      if(c.offset.save){ saveNeutralOffset(); bridageSaveToEEPROM(); }
+      break;
+  }
+}
+
+void cmdApplyPending(){
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  while(t != head.load(std::memory_order_acquire)){
+    const Cmd& c = ring[t & (CMD_QUEUE_DEPTH-1)];
+    apply(c);
+    uint32_t lat = halMicros() - c.tEnqUs;
+    if(!stat.n || lat<stat.mn) stat.mn=lat;
+    if(!stat.n || lat>stat.mx) stat.mx=lat;
+    stat.n++; stat.sum += lat;
+    applied.store(c.id, std::memory_order_release);
+    tail.store(++t, std::memory_order_release);
+  }
+}
+
+void cmdStatsReset(){ stat = {}; full = 0; }
+
+void cmdStatsPrint(){
+  if(!stat.n){ LOGI(LT_SYS, "cmd : aucune commande appliquée (file pleine x%lu)", (unsigned long)full); return; }
+  LOGI(LT_SYS, "cmd : n=%lu file->application min=%lu moy=%lu max=%lu us, file pleine x%lu",
+       (unsigned long)stat.n, (unsigned long)stat.mn, (unsigned long)(stat.sum / stat.n),
+       (unsigned long)stat.mx, (unsigned long)full);
+}
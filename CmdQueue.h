@@ -0,0 +1,37 @@
+// CmdQueue.h — File de commandes portail → boucle de contrôle (SPSC, sans verrou)
+#pragma once
+#include "Config.h"
+#include "Axes.h"
+#include "Curve.h"
+#include <WebServer.h>
+
+// Les routes HTTP ne touchent plus l'état de contrôle : elles valident les
+// arguments, postent une commande typée et répondent 202 + n° d'accusé.
+// La boucle applique les commandes en attente en début de tour (cmdApplyPending),
+// donc processControllers()/processADS() voient toujours une configuration entière.
+// La page suit l'application via /ack?id=N (portalAckJs(), Portal.h).
+
+#define CMD_QUEUE_DEPTH 8   // puissance de 2
+
+enum CmdType : uint8_t { CMD_PAD_LIMITS=0, CMD_RAMP_CURVE, CMD_NEUTRAL_OFFSET };
+
+struct Cmd {
+  CmdType  type;
+  uint32_t id;       // attribué par cmdPost()
+  uint32_t tEnqUs;
+  union {
+    struct { int16_t mn[AX_COUNT], mx[AX_COUNT]; uint8_t profile; } limits;   // /apply : bornes saisies (avant décalage neutre)
+    struct { uint16_t up[AX_COUNT], down[AX_COUNT]; uint8_t curve[AX_COUNT]; CurveParam param[AX_COUNT]; bool hasCurve; } ramp;   // /ramp
+    struct { int16_t val; bool save; } offset;               // /offset
+  };
+};
+
+enum CmdAck : uint8_t { ACK_UNKNOWN=0, ACK_PENDING, ACK_DONE };
+
+uint32_t cmdPost(Cmd& c);               // producteur (routes HTTP) ; 0 = file pleine
+void     cmdApplyPending();             // consommateur (loop, frontière de tour)
+CmdAck   cmdAckStatus(uint32_t id);
+void     cmdRespond(WebServer& server, uint32_t id);   // 202 + n° ou 503 si file pleine
+
+void cmdStatsReset();
+void cmdStatsPrint();                   // console série "cmd"
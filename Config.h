@@ -14,11 +14,8 @@
 #define BTN_R1 0x0010
 #define BTN_L1 0x0020
 
-// ----------- Fenêtre neutre base ----------
-extern int joyNeutralMin; // 482
-extern int joyNeutralMax; // 542
+// ----------- Décalage neutre (fenêtres dérivées : EffConfig.h) ----------
 extern int neutralOffset; // 512
-void updateNeutralWindow();
 void loadNeutralOffset();
 void saveNeutralOffset();
 
@@ -35,7 +32,7 @@ enum FaultCode : uint8_t {
 
 extern volatile uint8_t faultCode;
 extern bool pcaOK;
-extern bool adsOK[2];
+extern bool adsOK[];   // HAL_ADS_COUNT cartes (Hal.h)
 extern bool wiredNeutralOK;
 extern bool calibMode;
 extern bool safetyReady;
@@ -58,3 +55,305 @@ void ledSelfTest();
 #ifndef CAL_BTN_ACTIVE_HIGH
 #define CAL_BTN_ACTIVE_HIGH 0
 #endif
+
+// ----------- HAL (Hal.h) -----------
+// 0 = matériel réel (Wire/ADS1115/PCA9685/Bluepad32)
+// 1 = périphériques simulés + horloge virtuelle (banc sans carte)
+#ifndef HAL_SIM
+#define HAL_SIM 0
+#endif
+
+// ----------- Latence entrée → sortie (Latency.h) -----------
+// Broche de marquage oscilloscope : haut à l'acquisition, bas après écriture PCA.
+// -1 = désactivé
+#ifndef LAT_MARKER_PIN
+#define LAT_MARKER_PIN -1
+#endif
+
+// ----------- Bus I2C (I2cSched.h) -----------
+// I2C_DUAL_BUS : 1 = PCA9685 sur le second contrôleur (Wire1, broches I2C1_SDA/I2C1_SCL) ;
+//   une tâche d'envoi pousse les rafales pendant que la boucle lit les ADS sur Wire.
+//   0 = ADS et PCA sur Wire (historique). Sans objet en OUTPUT_LEDC.
+#ifndef I2C_DUAL_BUS
+#define I2C_DUAL_BUS 0
+#endif
+#ifndef I2C1_SDA
+#define I2C1_SDA 16
+#endif
+#ifndef I2C1_SCL
+#define I2C1_SCL 17
+#endif
+// Diagnostic (watchdog, portail, console) après le dernier commit du tour, dans ce budget.
+// ADS_DIAG_MAX_AGE_MS : le portail réutilise le scan du chemin de contrôle s'il a moins de
+//   cet âge ; sinon il demande une relecture, un axe par tour, sans attendre le bus.
+#ifndef I2C_DIAG_BUDGET_US
+#define I2C_DIAG_BUDGET_US 1500
+#endif
+#ifndef ADS_DIAG_MAX_AGE_MS
+#define ADS_DIAG_MAX_AGE_MS 150
+#endif
+
+// ----------- Étage de sortie (Output.h) -----------
+// OUTPUT_BACKEND : OUTPUT_PCA9685 = voies AXES[].pwm/.tor des PCA9685 en I2C (historique)
+//                  OUTPUT_LEDC    = LEDC (proportionnel) + GPIO (TOR) de l'ESP32, sans trafic bus
+// OUT_PWM_PINS / OUT_TOR_PINS : broche par axe (X,Y,Z,LX,LY,LZ,R1,R2), -1 = non câblée.
+//   Pas de brochage par défaut : une fois les broches de la carte prises, il reste au plus
+//   13 GPIO de sortie (0, 2, 4, 5, 12..19, 23) pour 16 voies. OUTPUT_LEDC exige donc les deux
+//   listes, définies ici ou en -D selon le câblage réel.
+//   Refusées à la compilation : GPIO 6..11 (flash), 34..39 (entrées seules), broches déjà prises.
+//   Broches de configuration (strapping) 0, 2, 5, 12, 15 : lues au reset, une charge ou un
+//   étage de puissance qui les tire peut empêcher le démarrage (0/2 : mode de boot, 12 :
+//   tension flash, 5/15 : timing SDIO). À éviter ; sinon, le câblage doit laisser la broche
+//   à son niveau de strapping pendant le reset (0, 5, 15 : haut ; 2, 12 : bas).
+#define OUTPUT_PCA9685 0
+#define OUTPUT_LEDC    1
+#ifndef OUTPUT_BACKEND
+#define OUTPUT_BACKEND OUTPUT_PCA9685
+#endif
+#if OUTPUT_BACKEND == OUTPUT_LEDC && !(defined(OUT_PWM_PINS) && defined(OUT_TOR_PINS))
+#error "OUTPUT_LEDC : définir OUT_PWM_PINS et OUT_TOR_PINS selon le câblage (Config.h, Étage de sortie)"
+#endif
+#ifndef OUT_PWM_PINS
+#define OUT_PWM_PINS { -1, -1, -1, -1, -1, -1, -1, -1 }   // PCA9685 : inutilisées
+#endif
+#ifndef OUT_TOR_PINS
+#define OUT_TOR_PINS { -1, -1, -1, -1, -1, -1, -1, -1 }
+#endif
+#ifndef OUT_LEDC_FREQ_HZ
+#define OUT_LEDC_FREQ_HZ 1000   // même fréquence que les PCA9685
+#endif
+
+// ----------- Acquisition joysticks filaires (IOMap.cpp) -----------
+// ADS_DATA_RATE_SPS : 8/16/32/64/128/250/475/860 (128 = défaut ADS1115 historique)
+// ADS_OVERSAMPLE    : conversions moyennées par axe et par scan (1, 2, 4, 8 ou 16).
+//   Latence d'un scan ≈ 4 tours × ADS_OVERSAMPLE × (1/ADS_DATA_RATE_SPS).
+//   Ex. 860 SPS × 4 : ~19 ms et bruit ÷2 ; 128 SPS × 1 : ~31 ms (historique).
+// ADS_SCAN_MAX_MS   : borne vérifiée à la compilation sur cette latence (la boucle est
+//   bloquée pendant le scan). 64 ms exclut 8/16/32 SPS et 128 SPS × 16 (~500 ms) ;
+//   à relever sciemment pour une machine lente.
+// JOY_NEUTRAL_HALF_WINDOW : demi-fenêtre neutre en points MAP ; la commande
+//   "noise" de la console mesure le bruit réel pour la justifier.
+#ifndef ADS_DATA_RATE_SPS
+#define ADS_DATA_RATE_SPS 128
+#endif
+#ifndef ADS_OVERSAMPLE
+#define ADS_OVERSAMPLE 1
+#endif
+#ifndef ADS_SCAN_MAX_MS
+#define ADS_SCAN_MAX_MS 64
+#endif
+#ifndef JOY_NEUTRAL_HALF_WINDOW
+#define JOY_NEUTRAL_HALF_WINDOW 30
+#endif
+
+// ACQ_BACKEND : ACQ_ADS1115 = ADS1115 en I2C, table AXES[].ads/.ch (historique)
+//               ACQ_SPI_ADC = CAN SPI 8 voies 12 bits type MCP3208 sur un hôte SPI libre,
+//                             une trame DMA par scan (une transaction par axe), hors bus I2C
+// ACQ_SPI_CHANNELS : voie du CAN par axe (X,Y,Z,LX,LY,LZ,R1,R2). Mesures remises à
+//   l'échelle 0..32767 : calibration, inversion et fenêtres inchangées.
+// Brochage par défaut = VSPI natif (18, 19, 23, 5) : à exclure de OUT_PWM_PINS/OUT_TOR_PINS si OUTPUT_LEDC.
+#define ACQ_ADS1115 0
+#define ACQ_SPI_ADC 1
+#ifndef ACQ_BACKEND
+#define ACQ_BACKEND ACQ_ADS1115
+#endif
+#ifndef ACQ_SPI_CHANNELS
+#define ACQ_SPI_CHANNELS { 0, 1, 2, 3, 4, 5, 6, 7 }
+#endif
+#ifndef ACQ_SPI_HOST
+#define ACQ_SPI_HOST 2          // SPI3_HOST (VSPI) ; 1 = SPI2_HOST (HSPI)
+#endif
+#ifndef ACQ_SPI_SCK
+#define ACQ_SPI_SCK  18
+#endif
+#ifndef ACQ_SPI_MISO
+#define ACQ_SPI_MISO 19
+#endif
+#ifndef ACQ_SPI_MOSI
+#define ACQ_SPI_MOSI 23
+#endif
+#ifndef ACQ_SPI_CS
+#define ACQ_SPI_CS   5
+#endif
+#ifndef ACQ_SPI_CLOCK_HZ
+#define ACQ_SPI_CLOCK_HZ 1000000   // MCP3208 : 1 MHz à 2,7 V, 2 MHz à 5 V
+#endif
+
+// Fenêtre neutre par axe déduite du bruit mesuré en calibration (phase neutre) :
+// demi-fenêtre = max(K·sigma, crête/2) + marge, bornée à [MIN..MAX] points MAP.
+#ifndef CAL_NEUTRAL_SIGMA_K
+#define CAL_NEUTRAL_SIGMA_K 5
+#endif
+#ifndef CAL_NEUTRAL_MARGIN
+#define CAL_NEUTRAL_MARGIN 4
+#endif
+#ifndef CAL_NEUTRAL_MIN_HALF
+#define CAL_NEUTRAL_MIN_HALF 8
+#endif
+#ifndef CAL_NEUTRAL_MAX_HALF
+#define CAL_NEUTRAL_MAX_HALF 60
+#endif
+
+// Calibration par balayage : tous les axes suivis en même temps. Un extrême est
+// acquis quand il s'écarte du neutre d'au moins MIN_TRAVEL_PCT % de la demi‑course
+// estimée (pré‑calibration) et ne s'éloigne plus de GROW_RAW pas bruts de son
+// ancre pendant STABLE_MS : une poussée lente et continue n'est pas une butée.
+// 0 = mode historique (un appui court par extrême) ; un appui court pendant
+// le balayage bascule aussi dans ce mode, extrêmes déjà acquis conservés.
+#ifndef CAL_SWEEP_ENABLE
+#define CAL_SWEEP_ENABLE 1
+#endif
+#ifndef CAL_SWEEP_MIN_TRAVEL_PCT
+#define CAL_SWEEP_MIN_TRAVEL_PCT 75
+#endif
+#ifndef CAL_SWEEP_GROW_RAW
+#define CAL_SWEEP_GROW_RAW 64
+#endif
+#ifndef CAL_SWEEP_STABLE_MS
+#define CAL_SWEEP_STABLE_MS 1500
+#endif
+
+// ----------- Manette de secours (Controllers.cpp) -----------
+// 1 = une 2e manette connectée reste en veille ; si la principale décroche
+// alors que le système est armé, la secours reprend la main sans réarmement,
+// à condition d'être neutre (axes + boutons PS/START relâchés) depuis FAILOVER_NEUTRAL_MS.
+#ifndef FAILOVER_ENABLE
+#define FAILOVER_ENABLE 1
+#endif
+#ifndef FAILOVER_NEUTRAL_MS
+#define FAILOVER_NEUTRAL_MS 300
+#endif
+
+// ----------- Reconnexion manettes (Controllers.cpp) -----------
+// 0 = clés Bluetooth effacées à chaque démarrage : découverte + appairage complets.
+// 1 = manettes appairées conservées : elles se reconnectent seules, sans découverte.
+#ifndef PAD_KEEP_BONDS
+#define PAD_KEEP_BONDS 0
+#endif
+// Liste blanche "AA:BB:CC:DD:EE:FF,11:22:..." (PAD_ALLOW_MAX adresses) ; vide = toute manette.
+// Filtrée par la pile Bluetooth (ni appairage ni reconnexion, même déjà appairée) ;
+// si elle passe quand même, elle est déconnectée et sa clé effacée, avant tout usage.
+#ifndef PAD_ALLOW_LIST
+#define PAD_ALLOW_LIST ""
+#endif
+#ifndef PAD_ALLOW_MAX
+#define PAD_ALLOW_MAX 8
+#endif
+
+// ----------- Profils de bridage (Bridage.h) -----------
+// Jeux de bornes manette résidents en RAM, tous précalculés dans EffConfig.
+// SELECT + flèche gauche/droite, axes au neutre : profil précédent/suivant,
+// sans écriture EEPROM ni Wi-Fi ; la page /bridage édite le profil actif.
+// Démarrage toujours sur le profil 0, quel que soit le profil actif à la sauvegarde.
+#ifndef BRIDAGE_PROFILES
+#define BRIDAGE_PROFILES 3             // 1..4 (1 = fonction absente)
+#endif
+#ifndef BRIDAGE_PROFILE_PULSE_MS
+#define BRIDAGE_PROFILE_PULSE_MS 150   // LED manette : n° du profil en impulsions
+#endif
+
+// ----------- Rampes des sorties (Ramp.h) -----------
+// Valeurs par défaut (ms neutre → pleine course / retour au neutre) tant que
+// l'EEPROM de bridage ne contient pas de rampes. 0 = instantané (comportement historique).
+#ifndef RAMP_ACCEL_MS_DEFAULT
+#define RAMP_ACCEL_MS_DEFAULT 0
+#endif
+#ifndef RAMP_DECEL_MS_DEFAULT
+#define RAMP_DECEL_MS_DEFAULT 0
+#endif
+
+// ----------- Courbes de réponse (Curve.h) -----------
+// Courbe par défaut de chaque axe tant que l'EEPROM de bridage n'en contient pas :
+// 0 = linéaire, 1 = expo 30 %, 2 = expo 60 %, 3 = S, 4 = zone fine,
+// 5 = expo réglable (CURVE_EXPO_PCT_DEFAULT), 6 = deux points de cassure (page /bridage)
+#ifndef CURVE_DEFAULT
+#define CURVE_DEFAULT 0
+#endif
+#ifndef CURVE_EXPO_PCT_DEFAULT
+#define CURVE_EXPO_PCT_DEFAULT 40
+#endif
+
+// ----------- Repos basse consommation (Power.h) -----------
+// Manette désarmée, ou sticks filaires au neutre, depuis POWER_IDLE_AFTER_MS :
+// CPU ralenti, Bluetooth connecté ; tick de POWER_IDLE_TICK_MS en mode manette seulement
+// (en filaire, le scan ADS garde le tick rapide pour voir un stick au tour suivant).
+// Rapport manette, stick hors neutre, sélecteur ou bouton : régime rapide au tick suivant.
+#ifndef POWER_IDLE_ENABLE
+#define POWER_IDLE_ENABLE 1
+#endif
+#ifndef POWER_IDLE_AFTER_MS
+#define POWER_IDLE_AFTER_MS 120000
+#endif
+#ifndef POWER_IDLE_TICK_MS
+#define POWER_IDLE_TICK_MS 50
+#endif
+#ifndef POWER_IDLE_CPU_MHZ
+#define POWER_IDLE_CPU_MHZ 80       // 80 minimum (APB, Bluetooth)
+#endif
+// Consommation nominale de la carte par régime : l'énergie de la console "power" n'est qu'une
+// estimation (résidence x ces valeurs), rien n'est mesuré ; à relever à l'ampèremètre.
+#ifndef POWER_ACTIVE_MA
+#define POWER_ACTIVE_MA 110
+#endif
+#ifndef POWER_IDLE_MA
+#define POWER_IDLE_MA 45
+#endif
+
+// ----------- Télémétrie UDP (Telemetry.h) -----------
+// 1 = trame binaire (voir Telemetry.h) envoyée en UDP vers un collecteur local.
+// Un échantillon tous les TELEMETRY_EVERY tours de loop(), TELEMETRY_BATCH
+// échantillons par paquet. Liaison : point d'accès du portail quand il est ouvert,
+// ou station si TELEMETRY_STA_SSID est renseigné. TELEMETRY_HOST vide = diffusion.
+#ifndef TELEMETRY_ENABLE
+#define TELEMETRY_ENABLE 0
+#endif
+#ifndef TELEMETRY_PORT
+#define TELEMETRY_PORT 4210
+#endif
+#ifndef TELEMETRY_EVERY
+#define TELEMETRY_EVERY 4
+#endif
+#ifndef TELEMETRY_BATCH
+#define TELEMETRY_BATCH 8
+#endif
+#ifndef TELEMETRY_HOST
+#define TELEMETRY_HOST ""
+#endif
+#ifndef TELEMETRY_STA_SSID
+#define TELEMETRY_STA_SSID ""
+#endif
+#ifndef TELEMETRY_STA_PASS
+#define TELEMETRY_STA_PASS ""
+#endif
+
+// ----------- Trace d'événements (Trace.h) -----------
+// 1 = intervalles (étapes de loop, transactions I2C, requêtes HTTP, écritures EEPROM)
+// dans un anneau RAM de TRACE_EVENTS x 12 octets, exporté par /trace.json (format
+// Chrome trace-event, ouvrir dans ui.perfetto.dev ou chrome://tracing).
+// Requêtes HTTP : seuls les passages de handleClient() d'au moins TRACE_HTTP_MIN_US.
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS 1024   // puissance de 2
+#endif
+#ifndef TRACE_HTTP_MIN_US
+#define TRACE_HTTP_MIN_US 100
+#endif
+
+// ----------- Micro-benchmarks (Bench.h) -----------
+// 1 = exécute benchRun() en fin de setup() (requiert HAL_SIM=1)
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE 0
+#endif
+
+// ----------- Journal série (Log.h) -----------
+// 0 = aucun, 1 = erreur, 2 = avertissement, 3 = info, 4 = debug
+// LOG_LEVEL_MAX : niveau compilé (au-dessus, les appels disparaissent du binaire)
+// LOG_LEVEL_DEFAULT : niveau actif au démarrage (modifiable à chaud)
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX 4
+#endif
+#ifndef LOG_LEVEL_DEFAULT
+#define LOG_LEVEL_DEFAULT 3
+#endif
@@ -0,0 +1,67 @@
+// Console.cpp — Console série de diagnostic
+#include "Console.h"
+#include "Log.h"
+#include "Latency.h"
+#include "Controllers.h"
+#include "IOMap.h"
+#include "Telemetry.h"
+#include "CmdQueue.h"
+#include "I2cSched.h"
+#include "Power.h"
+
+static char line[64];
+static uint8_t len = 0;
+
+static void cmdLog(char* args){
+  char* tag = strtok(args, " ");
+  char* lvl = strtok(nullptr, " ");
+  if(!tag || !lvl){ LOGI(LT_SYS, "usage: log <tag|all> <0..4>"); return; }
+  int l = atoi(lvl); if(l < LOG_NONE || l > LOG_DEBUG){ LOGI(LT_SYS, "niveau 0..4"); return; }
+  if(!strcasecmp(tag, "all")){ logSetLevel((LogLevel)l); LOGI(LT_SYS, "log all = %d", l); return; }
+  for(uint8_t t=0;t<LT_COUNT;t++){
+    if(!strcasecmp(tag, logTagName((LogTag)t))){ logSetTagLevel((LogTag)t,(LogLevel)l); LOGI(LT_SYS, "log %s = %d", tag, l); return; }
+  }
+  LOGI(LT_SYS, "tag inconnu : %s", tag);
+}
+
+static void execute(char* cmd){
+  char* args = strchr(cmd, ' ');
+  if(args){ *args++ = 0; while(*args==' ') args++; } else args = cmd + strlen(cmd);
+
+  if(!strcmp(cmd, "help")){
+    LOGI(LT_SYS, "help | lat [reset] | loop [reset] | cmd [reset] | i2c [reset] | power [reset] | pad | noise [reset] | log <tag|all> <0..4>");
+  } else if(!strcmp(cmd, "lat")){
+    if(!strcmp(args, "reset")){ latReset(); LOGI(LT_LAT, "histogrammes remis à zéro"); }
+    else latPrint();
+  } else if(!strcmp(cmd, "loop")){
+    if(!strcmp(args, "reset")){ loopStatsReset(); LOGI(LT_SYS, "temps de boucle remis à zéro"); }
+    else loopStatsPrint();
+  } else if(!strcmp(cmd, "cmd")){
+    if(!strcmp(args, "reset")){ cmdStatsReset(); LOGI(LT_SYS, "latence des commandes remise à zéro"); }
+    else cmdStatsPrint();
+  } else if(!strcmp(cmd, "i2c")){
+    if(!strcmp(args, "reset")){ i2cStatsReset(); LOGI(LT_I2C, "statistiques du bus remises à zéro"); }
+    else i2cStatsPrint();
+  } else if(!strcmp(cmd, "power")){
+    if(!strcmp(args, "reset")){ powerStatsReset(); LOGI(LT_SYS, "statistiques de repos remises à zéro"); }
+    else powerStatsPrint();
+  } else if(!strcmp(cmd, "pad")){
+    controllersPrintStats();
+  } else if(!strcmp(cmd, "noise")){
+    if(!strcmp(args, "reset")){ adsNoiseReset(); LOGI(LT_MAP, "mesure de bruit remise à zéro"); }
+    else adsNoisePrint();
+  } else if(!strcmp(cmd, "log")){
+    cmdLog(args);
+  } else if(*cmd){
+    LOGI(LT_SYS, "commande inconnue : %s (help)", cmd);
+  }
+}
+
+void consoleHandle(){
+  while(Serial.available() > 0){
+    int c = Serial.read();
+    if(c == '\r') continue;
+    if(c == '\n'){ line[len] = 0; execute(line); len = 0; continue; }
+    if(len < sizeof(line)-1) line[len++] = (char)c;
+  }
+}
@@ -0,0 +1,7 @@
+// Console.h — Console série de diagnostic (lecture non bloquante, une ligne = une commande)
+#pragma once
+#include "Config.h"
+
+// Commandes : help | lat [reset] | loop [reset] | cmd [reset] | pad | noise [reset] | log <tag|all> <0..4>
+// Les réponses passent par le journal asynchrone (Log.h).
+void consoleHandle();   // à appeler dans loop()
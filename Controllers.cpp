@@ -3,12 +3,17 @@
 #include "Faults.h"
 #include "IOMap.h"
 #include "Calibration.h"
-
-ControllerPtr myControllers[BP32_MAX_GAMEPADS];
-uint32_t psHoldStartMs[BP32_MAX_GAMEPADS] = {0}, rlHoldStartMs[BP32_MAX_GAMEPADS] = {0};
-bool psLastPressed[BP32_MAX_GAMEPADS] = {false}, psLongActionDone[BP32_MAX_GAMEPADS] = {false};
-bool psSeenReleasedSinceConnect[BP32_MAX_GAMEPADS] = {false}, rlBothLastPressed[BP32_MAX_GAMEPADS] = {false};
-bool optLastPressed[BP32_MAX_GAMEPADS] = {false};
+#include "Log.h"
+#include "Latency.h"
+#include "PadMap.h"
+#include "Ramp.h"
+#include "Output.h"
+#include "Power.h"
+
+uint32_t psHoldStartMs[HAL_PAD_SLOTS] = {0}, rlHoldStartMs[HAL_PAD_SLOTS] = {0};
+bool psLastPressed[HAL_PAD_SLOTS] = {false}, psLongActionDone[HAL_PAD_SLOTS] = {false};
+bool psSeenReleasedSinceConnect[HAL_PAD_SLOTS] = {false}, rlBothLastPressed[HAL_PAD_SLOTS] = {false};
+bool optLastPressed[HAL_PAD_SLOTS] = {false}, profLastPressed[HAL_PAD_SLOTS] = {false};
 
 bool safetyReady=false;
 bool softRadioOverride=false;
@@ -17,72 +22,274 @@ const uint32_t HOLD_BLINK_MS = 300;
 const uint32_t DEFAULT_PULSE_MS = 500;
 
 enum CtrlLedMode : uint8_t { LEDMODE_NORMAL=0, LEDMODE_HOLD_R1R1, LEDMODE_PULSES };
-struct CtrlLedState { CtrlLedMode mode=LEDMODE_NORMAL; uint32_t lastToggleMs=0; bool on=false; uint8_t pulsesDone=0,pulseTarget=0; uint8_t pr=0,pg=0,pb=0; uint32_t pulseMs=500; } ctrlLed[BP32_MAX_GAMEPADS];
+struct CtrlLedState { CtrlLedMode mode=LEDMODE_NORMAL; uint32_t lastToggleMs=0; bool on=false; uint8_t pulsesDone=0,pulseTarget=0; uint8_t pr=0,pg=0,pb=0; uint32_t pulseMs=500; } ctrlLed[HAL_PAD_SLOTS];
+
+static void setControllerColor(int slot,uint8_t r,uint8_t g,uint8_t b){ halPadSetColor(slot,r,g,b); }
+void triggerControllerPulses(int idx, uint8_t count, uint32_t pulseMs, uint8_t r, uint8_t g, uint8_t b);
+
+bool isAnyControllerConnected(){ for(uint8_t i=0;i<HAL_PAD_SLOTS;i++) if(halPadConnected(i)) return true; return false; }
+bool isWiredMode(){ return halDigitalRead(MODE_SEL_PIN)==LOW; }
+
+static int firstConnectedSlot(){ for(uint8_t i=0;i<HAL_PAD_SLOTS;i++) if(halPadConnected(i)) return i; return -1; }
+
+// Arrivée du dernier rapport Bluepad32 / dernier rapport appliqué aux sorties
+static uint32_t padReportUs = 0, padCommittedUs = 0;
+
+static bool lxInverted=false;
+
+// Trame mappée par slot : recalculée une fois par rapport, changement de bridage ou d'inversion LX
+static PadFrame padFrame[HAL_PAD_SLOTS];
+static bool padFrameFresh[HAL_PAD_SLOTS] = {false};
+
+// Statistiques de réception : rapports reçus / identiques (ignorés) / intervalle entre rapports utiles
+struct PadEventStats { uint32_t reports=0, unchanged=0, eventCommits=0, intervals=0, intervalMaxUs=0; uint64_t intervalSumUs=0; };
+static PadEventStats padStats;
+
+// Dernier rapport reçu par slot (les rapports identiques ne déclenchent rien)
+static PadSample lastSample[HAL_PAD_SLOTS];
+static bool lastSampleValid[HAL_PAD_SLOTS] = {false};
+
+static void invalidatePadFrames(){ for(auto& v:padFrameFresh) v=false; }
+
+static const PadFrame* padFrameFor(int slot){
+  if(slot<0 || slot>=HAL_PAD_SLOTS) return nullptr;
+  PadFrame& f = padFrame[slot];
+  if(!padFrameFresh[slot] || f.ver!=padMapVersion()){
+    PadSample ps; if(!halPadRead(slot, ps)) return nullptr;
+    padMapCompute(ps, lxInverted, f); f.tUs = padReportUs;
+    padFrameFresh[slot] = true;
+  }
+  return &f;
+}
+
+// ---------------- Arbitrage manette principale / secours ----------------
+// primarySlot pilote les sorties et reçoit PS/START ; standbySlot est surveillée en continu.
+static int primarySlot = -1, standbySlot = -1;
+static bool standbyNeutral = false;
+static uint32_t standbyNeutralSinceMs = 0;
+struct FailoverStats { uint32_t handovers=0, refused=0, lastUs=0, maxUs=0; };
+static FailoverStats foStats;
+
+static bool standbyReady(){
+#if FAILOVER_ENABLE
+  return standbySlot>=0 && standbyNeutral && (halMillis()-standbyNeutralSinceMs >= FAILOVER_NEUTRAL_MS);
+#else
+  return false;
+#endif
+}
+
+static void arbitrateSlots(){
+  // Tant que le système est armé, la principale ne change que par bascule (onDisconnectedController)
+  if(primarySlot<0 || !halPadConnected(primarySlot)) primarySlot = safetyReady? -1 : firstConnectedSlot();
+
+  if(standbySlot<0 || standbySlot==primarySlot || !halPadConnected(standbySlot)){
+    int s=-1;
+    for(uint8_t i=0;i<HAL_PAD_SLOTS;i++) if((int)i!=primarySlot && halPadConnected(i)){ s=i; break; }
+    if(s!=standbySlot){ standbySlot=s; standbyNeutral=false; }
+  }
+
+  PadSample ps; const PadFrame* f = (standbySlot>=0)? padFrameFor(standbySlot) : nullptr;
+  bool neutral = f && padMapNeutral(*f) && halPadRead(standbySlot, ps) && ps.misc==0;
+  if(neutral && !standbyNeutral) standbyNeutralSinceMs = halMillis();
+  standbyNeutral = neutral;
+}
+
+// Appelée sur perte de la principale alors que le système est armé
+static void failover(uint32_t t0Us){
+  if(standbyReady()){
+    int s = standbySlot;
+    primarySlot = s; standbySlot = -1; standbyNeutral = false;
+    psLastPressed[s]=false; psHoldStartMs[s]=0; psLongActionDone[s]=false; optLastPressed[s]=false; profLastPressed[s]=false;
+    const PadFrame* f = padFrameFor(s);
+    if(f && pcaOK){ const EffectiveConfig& c = effCfg(); for(uint8_t i=0;i<AX_COUNT;i++) applyAxisToPair(i, f->v[i], false, c); outCommit(); latMarkCommit(); }
+    uint32_t dt = halMicros() - t0Us;
+    foStats.handovers++; foStats.lastUs = dt; if(dt > foStats.maxUs) foStats.maxUs = dt;
+    triggerControllerPulses(s, 2, DEFAULT_PULSE_MS, 0,255,0);
+    LOGW(LT_PAD, "Bascule sur la manette de secours (slot %d) en %lu us, reste ARMÉ.", s, (unsigned long)dt);
+  } else {
+    safetyReady=false; halDigitalWrite(GPIO_MANETTE_CONNECTEE, false); neutralizeAllOutputs();
+    foStats.refused++;
+    LOGW(LT_PAD, "Manette principale perdue, secours %s : DÉSARMÉ.", standbySlot<0? "absente" : "non neutre");
+  }
+}
+
+// ---------------- Reconnexion : liste blanche et chronologie démarrage → armé ----------------
+static uint8_t allowList[PAD_ALLOW_MAX][6];
+static uint8_t allowCount = 0;
+static uint32_t padRefused = 0;
+
+// Instants en ms depuis la mise sous tension ; 0 = pas encore atteint
+struct ArmTimeline { uint32_t bootMs=0, padMs=0, armedMs=0; };
+static ArmTimeline timeline;
+
+void controllersSetAllowList(const char* csv){
+  allowCount = 0;
+  for(const char* p = csv; p && *p; ){
+    unsigned b[6]; int n = 0;
+    if(allowCount < PAD_ALLOW_MAX && sscanf(p, " %2x:%2x:%2x:%2x:%2x:%2x%n", &b[0],&b[1],&b[2],&b[3],&b[4],&b[5], &n) == 6){
+      for(int k=0;k<6;k++) allowList[allowCount][k] = (uint8_t)b[k];
+      allowCount++; p += n;
+    } else LOGW(LT_PAD, "PAD_ALLOW_LIST : entrée ignorée (%.*s)", (int)strcspn(p, ","), p);
+    p = strchr(p, ',');
+    if(p) p++;
+  }
+  halPadSetAllowList(allowList, allowCount);
+}
+
+static bool padAllowed(uint8_t slot, uint8_t a[6]){
+  if(!halPadAddress(slot, a)) return allowCount == 0;
+  if(!allowCount) return true;
+  for(uint8_t k=0;k<allowCount;k++) if(!memcmp(allowList[k], a, 6)) return true;
+  return false;
+}
+
+static void markArmed(){
+  if(timeline.armedMs || !timeline.bootMs) return;
+  timeline.armedMs = halMillis();
+  LOGI(LT_PAD, "Mise sous tension -> armé : %lu ms (prêt %lu, manette %lu).", (unsigned long)timeline.armedMs,
+       (unsigned long)timeline.bootMs, (unsigned long)timeline.padMs);
+}
 
-static void setControllerColor(ControllerPtr ctl,uint8_t r,uint8_t g,uint8_t b){ if(ctl&&ctl->isConnected()) ctl->setColorLED(r,g,b); }
+void controllersBootDone(){ timeline = ArmTimeline{}; timeline.bootMs = halMillis(); }
 
-bool isAnyControllerConnected(){ for(auto c:myControllers) if(c&&c->isConnected()) return true; return false; }
-bool isWiredMode(){ return digitalRead(MODE_SEL_PIN)==LOW; }
+String controllersTimelineJson(){
+  return "{\"bootMs\":" + String(timeline.bootMs) + ",\"padMs\":" + String(timeline.padMs)
+       + ",\"armedMs\":" + String(timeline.armedMs) + ",\"keepBonds\":" + String(PAD_KEEP_BONDS? "true" : "false")
+       + ",\"refused\":" + String(padRefused) + "}";
+}
 
-void onConnectedController(ControllerPtr ctl){
-  for(int i=0;i<BP32_MAX_GAMEPADS;i++) if(!myControllers[i]){ myControllers[i]=ctl; setControllerColor(ctl,255,0,0); return; }
-  Serial.println("[PAD] Manette connectée.");
+static void onConnectedController(uint8_t slot){
+  uint8_t a[6] = {0};
+  // Filet si la pile a laissé passer la manette : clé effacée, elle ne revient pas au démarrage
+  if(!padAllowed(slot, a)){
+    halPadDisconnect(slot); padRefused++;
+    if(a[0]|a[1]|a[2]|a[3]|a[4]|a[5]) halPadForgetAddress(a);
+    LOGW(LT_PAD, "Manette %02X:%02X:%02X:%02X:%02X:%02X refusée (hors PAD_ALLOW_LIST).", a[0],a[1],a[2],a[3],a[4],a[5]);
+    return;
+  }
+  padFrameFresh[slot]=false; lastSampleValid[slot]=false;
+  setControllerColor(slot,255,0,0);
+  if(!timeline.padMs && timeline.bootMs) timeline.padMs = halMillis();
+  LOGI(LT_PAD, "Manette %02X:%02X:%02X:%02X:%02X:%02X connectée (slot %u).", a[0],a[1],a[2],a[3],a[4],a[5], slot);
 }
-void onDisconnectedController(ControllerPtr ctl){
-  for(int i=0;i<BP32_MAX_GAMEPADS;i++) if(myControllers[i]==ctl){ myControllers[i]=nullptr; break; }
+static void onDisconnectedController(uint8_t slot){
+  uint32_t t0 = halMicros();
+  padFrameFresh[slot]=false; lastSampleValid[slot]=false;
+  if((int)slot==standbySlot){ standbySlot=-1; standbyNeutral=false; }
+  if((int)slot==primarySlot){ primarySlot=-1; if(safetyReady) failover(t0); }
   if(!isAnyControllerConnected()){ safetyReady=false; neutralizeAllOutputs(); }
-  Serial.println("[PAD] Manette déconnectée.");
+  LOGI(LT_PAD, "Manette déconnectée (slot %u).", slot);
+}
+
+void controllersSetup(){
+  halPadSetup(&onConnectedController,&onDisconnectedController);
+  controllersSetAllowList(PAD_ALLOW_LIST);
+  if(!PAD_KEEP_BONDS) halPadForgetKeys();
+  LOGI(LT_PAD, "Manettes appairées %s, liste blanche : %u adresse(s).", PAD_KEEP_BONDS? "conservées" : "effacées", allowCount);
+}
+
+
+static inline bool samePadSample(const PadSample& a, const PadSample& b){
+  return a.lx==b.lx && a.ly==b.ly && a.rx==b.rx && a.ry==b.ry && a.throttle==b.throttle && a.brake==b.brake
+      && a.dpad==b.dpad && a.buttons==b.buttons && a.misc==b.misc;
+}
+
+static_assert(HAL_PAD_SLOTS <= 8, "controllersUpdate() : un bit par slot dans un uint8_t");
+
+// Bit i = la manette du slot i a envoyé un rapport différent du précédent
+uint8_t controllersUpdate(){
+  if(!halPadUpdate()) return 0;
+  padStats.reports++;
+  uint8_t changed=0;
+  for(uint8_t i=0;i<HAL_PAD_SLOTS;i++){
+    PadSample ps;
+    if(!halPadRead(i, ps)){ lastSampleValid[i]=false; continue; }
+    if(!lastSampleValid[i] || !samePadSample(ps, lastSample[i])){ lastSample[i]=ps; lastSampleValid[i]=true; padFrameFresh[i]=false; changed|=(uint8_t)(1u<<i); }
+  }
+  if(!changed){ padStats.unchanged++; return 0; }
+
+  uint32_t now = halMicros();
+  if(padReportUs){
+    uint32_t dt = now - padReportUs;
+    padStats.intervals++; padStats.intervalSumUs += dt; if(dt > padStats.intervalMaxUs) padStats.intervalMaxUs = dt;
+  }
+  padReportUs = now;
+  if(primarySlot>=0 && (changed & (1u<<primarySlot))) latMarkAcquire();
+  powerActivity(PWR_PAD, now);
+  return changed;
+}
+
+// Remplace delay() en fin de loop() : sonde Bluepad32 toutes les ~1 ms et applique
+// immédiatement un rapport neuf de la manette principale au lieu d'attendre le tour
+// de boucle suivant (secours et manettes en attente : au tour suivant).
+// Au repos (Power.h) : sonde toutes les 5 ms, et un réveil raccourcit le tick en cours.
+void controllersWaitEvents(){
+  uint32_t t0 = halMillis();
+  for(;;){
+    uint8_t changed = controllersUpdate();
+    if(primarySlot>=0 && (changed & (1u<<primarySlot))){ padStats.eventCommits++; processControllers(); }
+    powerPoll();
+    if(halMillis() - t0 >= powerTickMs()) return;
+    halDelay(powerPollMs());
+  }
 }
 
-void controllersSetup(){ BP32.setup(&onConnectedController,&onDisconnectedController); BP32.forgetBluetoothKeys(); }
-void controllersUpdate(){ BP32.update(); }
+uint32_t controllersEventCommits(){ return padStats.eventCommits; }
+int controllersPrimarySlot(){ return primarySlot; }
+int controllersStandbySlot(){ return standbySlot; }
+
+void controllersPrintStats(){
+  LOGI(LT_PAD, "rapports=%lu identiques=%lu appliqués hors boucle=%lu",
+       (unsigned long)padStats.reports, (unsigned long)padStats.unchanged, (unsigned long)padStats.eventCommits);
+  LOGI(LT_PAD, "intervalle moy=%luus max=%luus (voir 'lat' pour rapport→PCA)",
+       (unsigned long)(padStats.intervals ? padStats.intervalSumUs / padStats.intervals : 0), (unsigned long)padStats.intervalMaxUs);
+  LOGI(LT_PAD, "principale=%d secours=%d (%s) bascules=%lu refus=%lu dernière=%luus max=%luus",
+       primarySlot, standbySlot, standbyReady()? "prête" : "non prête", (unsigned long)foStats.handovers,
+       (unsigned long)foStats.refused, (unsigned long)foStats.lastUs, (unsigned long)foStats.maxUs);
+  LOGI(LT_PAD, "démarrage : prêt %lu ms, 1re manette %lu ms, armé %lu ms (0 = pas encore) ; clés %s, refusées %lu",
+       (unsigned long)timeline.bootMs, (unsigned long)timeline.padMs, (unsigned long)timeline.armedMs,
+       PAD_KEEP_BONDS? "conservées" : "effacées", (unsigned long)padRefused);
+}
 
 void refreshControllersColor(){
-  for(int i=0;i<BP32_MAX_GAMEPADS;i++){
-    auto ctl=myControllers[i];
-    if(!ctl||!ctl->isConnected()||ctrlLed[i].mode!=LEDMODE_NORMAL) continue;
-    if(faultCode!=FC_NONE) { setControllerColor(ctl,255,0,0); continue; }
-    if(safetyReady) setControllerColor(ctl,0,255,0); else setControllerColor(ctl,0,0,255);
+  for(int i=0;i<HAL_PAD_SLOTS;i++){
+    if(!halPadConnected(i)||ctrlLed[i].mode!=LEDMODE_NORMAL) continue;
+    if(faultCode!=FC_NONE) { setControllerColor(i,255,0,0); continue; }
+    if(safetyReady) setControllerColor(i,0,255,0); else setControllerColor(i,0,0,255);
   }
 }
 
 void triggerControllerPulses(int idx, uint8_t count, uint32_t pulseMs, uint8_t r, uint8_t g, uint8_t b){
-  if(idx<0 || idx>=BP32_MAX_GAMEPADS) return;
+  if(idx<0 || idx>=HAL_PAD_SLOTS) return;
   ctrlLed[idx].mode = LEDMODE_PULSES;
   ctrlLed[idx].lastToggleMs = 0; ctrlLed[idx].on = false; ctrlLed[idx].pulsesDone = 0;
   ctrlLed[idx].pulseTarget = count; ctrlLed[idx].pulseMs = pulseMs; ctrlLed[idx].pr=r; ctrlLed[idx].pg=g; ctrlLed[idx].pb=b;
 }
 
 void serviceControllerLEDs(){
-  uint32_t now=millis();
-  for(int i=0;i<BP32_MAX_GAMEPADS;i++){
-    auto ctl=myControllers[i]; if(!ctl||!ctl->isConnected()) continue;
+  uint32_t now=halMillis();
+  for(int i=0;i<HAL_PAD_SLOTS;i++){
+    if(!halPadConnected(i)) continue;
     switch(ctrlLed[i].mode){
       case LEDMODE_NORMAL: break;
       case LEDMODE_HOLD_R1R1:
         if(now-ctrlLed[i].lastToggleMs>=HOLD_BLINK_MS){
           ctrlLed[i].lastToggleMs=now; ctrlLed[i].on=!ctrlLed[i].on;
-          setControllerColor(ctl, ctrlLed[i].on?0:255, ctrlLed[i].on?255:0, 0);
+          setControllerColor(i, ctrlLed[i].on?0:255, ctrlLed[i].on?255:0, 0);
         } break;
       case LEDMODE_PULSES:
         if(now-ctrlLed[i].lastToggleMs>=ctrlLed[i].pulseMs){
           ctrlLed[i].lastToggleMs=now; ctrlLed[i].on=!ctrlLed[i].on;
-          if(ctrlLed[i].on) setControllerColor(ctl, ctrlLed[i].pr, ctrlLed[i].pg, ctrlLed[i].pb);
-          else { setControllerColor(ctl, 0,0,0); if(++ctrlLed[i].pulsesDone>=ctrlLed[i].pulseTarget){ ctrlLed[i].mode=LEDMODE_NORMAL; refreshControllersColor(); } }
+          if(ctrlLed[i].on) setControllerColor(i, ctrlLed[i].pr, ctrlLed[i].pg, ctrlLed[i].pb);
+          else { setControllerColor(i, 0,0,0); if(++ctrlLed[i].pulsesDone>=ctrlLed[i].pulseTarget){ ctrlLed[i].mode=LEDMODE_NORMAL; refreshControllersColor(); } }
         } break;
     }
   }
 }
 
-static bool lxInverted=false;
-
-bool controllerAxesNeutral(ControllerPtr ctl){
-  if(!ctl) return false;
-  int vals[AX_COUNT];
-  if(!getPadValues(vals, ctl)) return false;
-  auto inN=[&](int v,int i){ return v>=padNeutralMin[i] && v<=padNeutralMax[i]; };
-  for(int i=0;i<AX_COUNT;i++) if(!inN(vals[i],i)) return false;
-  return true;
+bool controllerAxesNeutral(int slot){
+  const PadFrame* f = padFrameFor(slot);
+  return f && padMapNeutral(*f);
 }
 
 static bool canSoftOverrideToPad(){
@@ -98,23 +305,23 @@ void processR1L1Override(){
 
   bool okToOverride = canSoftOverrideToPad();
 
-  for(int i=0;i<BP32_MAX_GAMEPADS;i++){
-    auto ctl=myControllers[i]; if(!ctl||!ctl->isConnected()) continue;
-    uint16_t btn=ctl->buttons(); bool r1=(btn & BTN_R1), l1=(btn & BTN_L1), both=r1&&l1;
+  for(int i=0;i<HAL_PAD_SLOTS;i++){
+    PadSample ps; if(!halPadRead(i, ps)) continue;
+    uint16_t btn=ps.buttons; bool r1=(btn & BTN_R1), l1=(btn & BTN_L1), both=r1&&l1;
 
     if (both){
       if (!rlBothLastPressed[i]){
-        rlBothLastPressed[i]=true; rlHoldStartMs[i]=millis();
+        rlBothLastPressed[i]=true; rlHoldStartMs[i]=halMillis();
         ctrlLed[i].mode=LEDMODE_HOLD_R1R1; ctrlLed[i].lastToggleMs=0; ctrlLed[i].on=false;
-        Serial.println("[PAD] L1+R1 maintenus : tentative de passage en mode manette…");
+        LOGI(LT_PAD, "L1+R1 maintenus : tentative de passage en mode manette…");
         startBlink(LEDP_GREEN, 0xFFFFFFFF, 100);
-      } else if (millis()-rlHoldStartMs[i]>=10000){
+      } else if (halMillis()-rlHoldStartMs[i]>=10000){
         if (okToOverride){
           softRadioOverride=true; safetyReady=false; neutralizeAllOutputs();
           onModeChanged(false); // basculer totalement en mode manette
-          modeChangeBlockUntil=millis()+MODE_CHANGE_BLOCK_MS;
+          modeChangeBlockUntil=halMillis()+MODE_CHANGE_BLOCK_MS;
           triggerControllerPulses(i, 3, DEFAULT_PULSE_MS, 0,255,0);
-          Serial.println("[PAD] Passage logiciel en mode manette (GPIO33=0). PS 5s pour armer.");
+          LOGI(LT_PAD, "Passage logiciel en mode manette (GPIO33=0). PS 5s pour armer.");
           stopBlink(); startBlink(LEDP_GREEN, 3000, 500);
         } else {
           ctrlLed[i].mode=LEDMODE_NORMAL;
@@ -135,87 +342,73 @@ void processR1L1Override(){
 void processControllers() {
   if(isEffectiveWiredMode()) return; // ignore pad axes in joystick mode
 
-  ControllerPtr ctl=nullptr; int idx=-1;
-  for (int i = 0; i < BP32_MAX_GAMEPADS; ++i) {
-    if (myControllers[i] && myControllers[i]->isConnected()) { ctl = myControllers[i]; idx = i; break; }
-  }
-  if (!ctl) { neutralizeAllOutputs(); return; }
+  arbitrateSlots();
+  int idx = primarySlot;
+  PadSample ps;
+  if (idx < 0 || !halPadRead(idx, ps)) { neutralizeAllOutputs(); return; }
 
-  const uint8_t MISC_BUTTON_SYSTEM = 0x01;
-  bool psPressed = (ctl->miscButtons() & MISC_BUTTON_SYSTEM);
-  uint32_t now = millis();
+  bool psPressed = (ps.misc & PAD_MISC_SYSTEM);
+  uint32_t now = halMillis();
 
   if (psPressed && !psLastPressed[idx]) {
     psHoldStartMs[idx] = now; psLastPressed[idx] = true; psLongActionDone[idx] = false; psSeenReleasedSinceConnect[idx] = true;
   } else if (psPressed && psLastPressed[idx]) {
     if (!psLongActionDone[idx] && (now - psHoldStartMs[idx] >= 5000)) {
-      if (!safetyReady) { if (controllerAxesNeutral(ctl)) { safetyReady = true; digitalWrite(GPIO_MANETTE_CONNECTEE, true); Serial.println("[PAD] ARMÉ."); } else Serial.println("[PAD] REFUS ARMEMENT : axes non neutres."); }
-      else { safetyReady = false; digitalWrite(GPIO_MANETTE_CONNECTEE, false); neutralizeAllOutputs(); Serial.println("[PAD] DÉSARMÉ."); }
+      if (!safetyReady) { if (controllerAxesNeutral(idx)) { safetyReady = true; halDigitalWrite(GPIO_MANETTE_CONNECTEE, true); LOGI(LT_PAD, "ARMÉ."); markArmed(); } else LOGW(LT_PAD, "REFUS ARMEMENT : axes non neutres."); }
+      else { safetyReady = false; halDigitalWrite(GPIO_MANETTE_CONNECTEE, false); neutralizeAllOutputs(); LOGI(LT_PAD, "DÉSARMÉ."); }
       psLongActionDone[idx] = true; refreshControllersColor();
     }
   } else if (!psPressed && psLastPressed[idx]) {
     uint32_t held = now - psHoldStartMs[idx];
     if (held >= 50 && held < 5000) {
-      if (safetyReady) { safetyReady=false; digitalWrite(GPIO_MANETTE_CONNECTEE,false); neutralizeAllOutputs(); refreshControllersColor(); Serial.println("[PAD] DÉSARMÉ (PS court)."); }
+      if (safetyReady) { safetyReady=false; halDigitalWrite(GPIO_MANETTE_CONNECTEE,false); neutralizeAllOutputs(); refreshControllersColor(); LOGI(LT_PAD, "DÉSARMÉ (PS court)."); }
     }
     psLastPressed[idx] = false; psHoldStartMs[idx] = 0;
   }
 
-  const uint8_t MISC_BUTTON_START = 0x04;
-  bool optPressed = (ctl->miscButtons() & MISC_BUTTON_START);
+  bool optPressed = (ps.misc & PAD_MISC_START);
   if (optPressed && !optLastPressed[idx]) {
-    if (!safetyReady) { lxInverted = !lxInverted; Serial.printf("[PAD] Inversion LX = %s\n", lxInverted?"ACTIVE":"NORMALE"); triggerControllerPulses(idx, lxInverted?3:2, DEFAULT_PULSE_MS, 0,255,0); }
-    else Serial.println("[PAD] Inversion LX ignorée (système armé).");
+    if (!safetyReady) { lxInverted = !lxInverted; invalidatePadFrames(); LOGI(LT_PAD, "Inversion LX = %s", lxInverted?"ACTIVE":"NORMALE"); triggerControllerPulses(idx, lxInverted?3:2, DEFAULT_PULSE_MS, 0,255,0); }
+    else LOGW(LT_PAD, "Inversion LX ignorée (système armé).");
   }
   optLastPressed[idx] = optPressed;
 
-  int rawLX = ctl->axisX(); if (lxInverted) rawLX = -rawLX;
-  int X  = constrain(map(ctl->axisRX(), -512, 512, padMapMin[AX_X],  padMapMax[AX_X]), padMapMin[AX_X], padMapMax[AX_X]);
-  int Y  = constrain(map(ctl->axisRY(), -512, 512, padMapMin[AX_Y],  padMapMax[AX_Y]), padMapMin[AX_Y], padMapMax[AX_Y]);
-  int LX = constrain(map(rawLX,         -512, 512, padMapMin[AX_LX], padMapMax[AX_LX]), padMapMin[AX_LX], padMapMax[AX_LX]);
-  int LY = constrain(map(ctl->axisY(),  -512, 512, padMapMin[AX_LY], padMapMax[AX_LY]), padMapMin[AX_LY], padMapMax[AX_LY]);
-  int Z  = padNeutral[AX_Z];
-  if (ctl->throttle() > 0)
-    Z = constrain(map(ctl->throttle(), 0, 1023, padNeutral[AX_Z], padMapMin[AX_Z]), padMapMin[AX_Z], padMapMax[AX_Z]);
-  else if (ctl->brake() > 0)
-    Z = constrain(map(ctl->brake(),    0, 1023, padNeutral[AX_Z], padMapMax[AX_Z]), padMapMin[AX_Z], padMapMax[AX_Z]);
-  int LZ = padNeutral[AX_LZ]; uint8_t d = ctl->dpad();
-  if (d == 0x01) LZ = padMapMax[AX_LZ];
-  else if (d == 0x02) LZ = padMapMin[AX_LZ];
-  int R1 = padNeutral[AX_R1], R2 = padNeutral[AX_R2];
-  uint16_t b = ctl->buttons();
-  if (b & 0x0001) R1 = padMapMin[AX_R1]; else if (b & 0x0002) R1 = padMapMax[AX_R1];
-  if (b & 0x0004) R2 = padMapMin[AX_R2]; else if (b & 0x0008) R2 = padMapMax[AX_R2];
+  // SELECT + flèche gauche/droite : profil de bridage précédent/suivant. Axes au neutre
+  // seulement (pas de saut de sortie) ; effet dès la trame ci-dessous, sans EEPROM ni Wi-Fi.
+  uint8_t profDir = (ps.misc & PAD_MISC_SELECT)? (ps.dpad & (PAD_DPAD_LEFT|PAD_DPAD_RIGHT)) : 0;
+  if (BRIDAGE_PROFILES > 1 && profDir && !profLastPressed[idx]) {
+    if (controllerAxesNeutral(idx)) {
+      uint8_t p = (bridageProfile + ((profDir & PAD_DPAD_RIGHT)? 1 : BRIDAGE_PROFILES-1)) % BRIDAGE_PROFILES;
+      bridageSelectProfile(p);
+      triggerControllerPulses(idx, p+1, BRIDAGE_PROFILE_PULSE_MS, 0,255,255);
+      LOGI(LT_PAD, "Profil de bridage %u/%u : %s", p+1, BRIDAGE_PROFILES, bridageProfileName(p));
+    } else LOGW(LT_PAD, "Changement de profil refusé : axes non neutres.");
+  }
+  profLastPressed[idx] = profDir != 0;
+
+  const PadFrame* f = padFrameFor(idx);
+  if (!f) { neutralizeAllOutputs(); return; }
 
   if (pcaOK && safetyReady) {
-    applyAxisToPair(0, X); applyAxisToPair(1, Y); applyAxisToPair(2, Z); applyAxisToPair(3, LX);
-    applyAxisToPair(4, LY); applyAxisToPair(5, LZ); applyAxisToPair(6, R1); applyAxisToPair(7, R2);
+    const EffectiveConfig& c = effCfg();   // un seul instantané pour toute la trame
+    for (uint8_t i = 0; i < AX_COUNT; i++) applyAxisToPair(i, rampStep(i, f->v[i], c), false, c);
+    outCommit(); latMarkCommit();
+    // Un même rapport peut être réappliqué à chaque loop() : seule la première écriture compte
+    if (padReportUs != padCommittedUs) {
+      for (uint8_t i = 0; i < AX_COUNT; i++) latRecord(LAT_SRC_PAD, i, padReportUs);
+      padCommittedUs = padReportUs;
+    }
   } else {
     neutralizeAllOutputs();
   }
 }
 
 
-bool getPadValues(int out[AX_COUNT], ControllerPtr ctl){
-  if(!ctl){
-    for(int i=0;i<BP32_MAX_GAMEPADS;i++){
-      if(myControllers[i] && myControllers[i]->isConnected()){ ctl=myControllers[i]; break; }
-    }
-
-  }
-  if(!ctl){ for(int i=0;i<AX_COUNT;i++) out[i]=0; return false; }
-  int rawLX = ctl->axisX(); if(lxInverted) rawLX = -rawLX;
-  out[AX_X]  = constrain(map(ctl->axisRX(), -512, 512, padMapMin[AX_X],  padMapMax[AX_X]), padMapMin[AX_X], padMapMax[AX_X]);
-  out[AX_Y]  = constrain(map(ctl->axisRY(), -512, 512, padMapMin[AX_Y],  padMapMax[AX_Y]), padMapMin[AX_Y], padMapMax[AX_Y]);
-  out[AX_LX] = constrain(map(rawLX,         -512, 512, padMapMin[AX_LX], padMapMax[AX_LX]), padMapMin[AX_LX], padMapMax[AX_LX]);
-  out[AX_LY] = constrain(map(ctl->axisY(),  -512, 512, padMapMin[AX_LY], padMapMax[AX_LY]), padMapMin[AX_LY], padMapMax[AX_LY]);
-  out[AX_Z]  = padNeutral[AX_Z];
-  if(ctl->throttle()>0)      out[AX_Z]=constrain(map(ctl->throttle(),0,1023,padNeutral[AX_Z],padMapMin[AX_Z]), padMapMin[AX_Z], padMapMax[AX_Z]);
-  else if(ctl->brake()>0)    out[AX_Z]=constrain(map(ctl->brake(),   0,1023,padNeutral[AX_Z],padMapMax[AX_Z]), padMapMin[AX_Z], padMapMax[AX_Z]);
-  out[AX_LZ]=padNeutral[AX_LZ]; uint8_t d=ctl->dpad(); if(d==0x01) out[AX_LZ]=padMapMax[AX_LZ]; else if(d==0x02) out[AX_LZ]=padMapMin[AX_LZ];
-  out[AX_R1]=padNeutral[AX_R1]; out[AX_R2]=padNeutral[AX_R2]; uint16_t b=ctl->buttons();
-  if(b&0x0001) out[AX_R1]=padMapMin[AX_R1]; else if(b&0x0002) out[AX_R1]=padMapMax[AX_R1];
-  if(b&0x0004) out[AX_R2]=padMapMin[AX_R2]; else if(b&0x0008) out[AX_R2]=padMapMax[AX_R2];
+bool getPadValues(int out[AX_COUNT], int slot){
+  if(slot<0) slot=firstConnectedSlot();
+  const PadFrame* f = padFrameFor(slot);
+  if(!f){ for(int i=0;i<AX_COUNT;i++) out[i]=0; return false; }
+  memcpy(out, f->v, sizeof(f->v));
   return true;
 }
 
@@ -229,17 +422,17 @@ void updateStatusLEDs(){
   bool connected = isAnyControllerConnected();
 
   if (wired){
-    digitalWrite(GPIO_MANETTE_CONNECTEE, wiredNeutralOK);
+    halDigitalWrite(GPIO_MANETTE_CONNECTEE, wiredNeutralOK);
     digitalWrite(LED_ROUGE_PIN, LOW);
     digitalWrite(LED_VERTE_PIN, HIGH);
   } else {
-    digitalWrite(GPIO_MANETTE_CONNECTEE, safetyReady);
+    halDigitalWrite(GPIO_MANETTE_CONNECTEE, safetyReady);
     if (connected && safetyReady){
       digitalWrite(LED_VERTE_PIN, HIGH);
       digitalWrite(LED_ROUGE_PIN, LOW);
     } else if (connected){
       static uint32_t t0=0; static bool on=false;
-      if(millis()-t0>=600){ t0=millis(); on=!on; }
+      if(halMillis()-t0>=600){ t0=halMillis(); on=!on; }
       digitalWrite(LED_VERTE_PIN,on); digitalWrite(LED_ROUGE_PIN,LOW);
     } else {
       digitalWrite(LED_VERTE_PIN,LOW); digitalWrite(LED_ROUGE_PIN,HIGH);
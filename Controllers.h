@@ -1,24 +1,31 @@
 #pragma once
 #include "Config.h"
-#include <Bluepad32.h>
+#include "Hal.h"
 #include "Bridage.h"
 
-extern ControllerPtr myControllers[BP32_MAX_GAMEPADS];
 extern bool safetyReady;
 extern bool softRadioOverride;
 
-void controllersSetup();
-void controllersUpdate();
+void controllersSetup();                  // PAD_KEEP_BONDS, PAD_ALLOW_LIST (Config.h)
+void controllersSetAllowList(const char* csv);   // "AA:BB:CC:DD:EE:FF,..." ; "" = toute manette
+void controllersBootDone();               // fin de setup() : origine de la chronologie prêt → manette → armé
+String controllersTimelineJson();         // /status.json
+uint8_t controllersUpdate();              // bit i = rapport neuf (différent du précédent) sur le slot i
+void controllersWaitEvents();             // attente de fin de tick (powerTickMs) réactive aux rapports
+void controllersPrintStats();
+uint32_t controllersEventCommits();       // rapports de la principale appliqués pendant l'attente
+int  controllersPrimarySlot();           // manette qui pilote (-1 = aucune)
+int  controllersStandbySlot();           // manette de secours surveillée (-1 = aucune)
 void processControllers();
 void processR1L1Override();
 void serviceControllerLEDs();
 void refreshControllersColor();
 
-bool controllerAxesNeutral(ControllerPtr ctl);
+bool controllerAxesNeutral(int slot);
 bool isAnyControllerConnected();
 void updateStatusLEDs();
 
 extern const uint32_t DEFAULT_PULSE_MS;
 
-bool getPadValues(int out[AX_COUNT], ControllerPtr ctl=nullptr);
+bool getPadValues(int out[AX_COUNT], int slot=-1);   // slot -1 = première manette connectée
 
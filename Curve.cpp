@@ -0,0 +1,123 @@
+// Curve.cpp — Courbes de réponse par axe (table d'interpolation entière)
+#include "Curve.h"
+#include <array>
+
+typedef std::array<uint16_t, CURVE_POINTS> CurveLut;
+
+static constexpr int32_t knotX(int i){ return (int32_t)i * CURVE_ONE / CURVE_SEGS; }
+
+static constexpr CurveLut makeLinear(){
+  CurveLut t{}; for(int i=0;i<CURVE_POINTS;i++) t[i]=(uint16_t)knotX(i); return t;
+}
+
+// y = (1-k)·x + k·x³ : k en %, plus fin autour du neutre quand k augmente
+static constexpr CurveLut makeExpo(int kPct){
+  CurveLut t{};
+  for(int i=0;i<CURVE_POINTS;i++){
+    int64_t x=knotX(i), x3=x*x*x/((int64_t)CURVE_ONE*CURVE_ONE);
+    t[i]=(uint16_t)(((100-kPct)*x + kPct*x3)/100);
+  }
+  return t;
+}
+
+// Smoothstep 3x² − 2x³ : démarrage et arrivée progressifs
+static constexpr CurveLut makeS(){
+  CurveLut t{};
+  for(int i=0;i<CURVE_POINTS;i++){
+    int64_t x=knotX(i), x2=x*x/CURVE_ONE, x3=x2*x/CURVE_ONE;
+    t[i]=(uint16_t)(3*x2 - 2*x3);
+  }
+  return t;
+}
+
+// Segments de droite entre points (x croissants, de 0 à CURVE_ONE)
+struct CurveKnot { int32_t x, y; };
+template<size_t N>
+static constexpr CurveLut makePiecewise(const CurveKnot (&k)[N]){
+  CurveLut t{};
+  for(int i=0;i<CURVE_POINTS;i++){
+    int32_t x=knotX(i); size_t s=0;
+    while(s+2<N && x>k[s+1].x) s++;
+    t[i]=(uint16_t)(k[s].y + (int64_t)(k[s+1].y-k[s].y)*(x-k[s].x)/(k[s+1].x-k[s].x));
+  }
+  return t;
+}
+
+// Zone fine : la moitié de la course ne donne que 20 % de la commande
+static constexpr CurveKnot FINE_KNOTS[] = { {0,0}, {512,205}, {768,512}, {CURVE_ONE,CURVE_ONE} };
+
+static constexpr int CURVE_PRESETS = CURVE_EXPO;   // CurveId < CURVE_EXPO : table constexpr
+static constexpr CurveLut PRESETS[CURVE_PRESETS] = {
+  makeLinear(), makeExpo(30), makeExpo(60), makeS(), makePiecewise(FINE_KNOTS)
+};
+static const char* const NAMES[CURVE_COUNT] = { "lineaire", "expo 30%", "expo 60%", "S", "zone fine", "expo réglable", "cassures" };
+
+static constexpr bool curveValid(const CurveLut& t){
+  if(t[0]!=0 || t[CURVE_POINTS-1]!=CURVE_ONE) return false;   // butées conservées
+  for(int i=1;i<CURVE_POINTS;i++) if(t[i]<t[i-1]) return false; // monotone
+  return true;
+}
+static constexpr bool allPresetsValid(){ for(const auto& p:PRESETS) if(!curveValid(p)) return false; return true; }
+static_assert(allPresetsValid(), "préréglage de courbe non monotone ou butées modifiées");
+static_assert(PRESETS[CURVE_LINEAR][CURVE_SEGS/2]==CURVE_ONE/2, "courbe linéaire incorrecte");
+static constexpr bool allExpoValid(){ for(int k=0;k<=100;k++) if(!curveValid(makeExpo(k))) return false; return true; }
+static_assert(allExpoValid(), "expo réglable non monotone");
+
+uint8_t curveId[AX_COUNT];
+CurveParam curveParam[AX_COUNT];
+static CurveLut built[AX_COUNT];                 // courbes réglables de l'axe
+static const uint16_t* lut[AX_COUNT];            // table utilisée ; nullptr = linéaire (valeur inchangée)
+
+const char* curveName(uint8_t id){ return (id<CURVE_COUNT)? NAMES[id] : "?"; }
+
+static inline uint8_t pct(uint8_t v, uint8_t lo, uint8_t hi){ return v<lo? lo : v>hi? hi : v; }
+static inline int32_t fromPct(uint8_t v){ return (int32_t)v * CURVE_ONE / 100; }
+
+void curveCompile(uint8_t axis){
+  if(axis>=AX_COUNT) return;
+  uint8_t id = curveId[axis];
+  if(id>=CURVE_COUNT) id = curveId[axis] = CURVE_LINEAR;
+  CurveParam& p = curveParam[axis];
+  if(id==CURVE_LINEAR || (id==CURVE_EXPO && p.expo==0)){ lut[axis]=nullptr; return; }
+  if(id<CURVE_PRESETS){ lut[axis]=PRESETS[id].data(); return; }
+  if(id==CURVE_EXPO){
+    p.expo = pct(p.expo, 0, 100);
+    built[axis] = makeExpo(p.expo);
+  } else {
+    p.x1 = pct(p.x1, 1, 98); p.x2 = pct(p.x2, p.x1+1, 99);
+    p.y1 = pct(p.y1, 0, 100); p.y2 = pct(p.y2, p.y1, 100);
+    const CurveKnot k[] = { {0,0}, {fromPct(p.x1),fromPct(p.y1)}, {fromPct(p.x2),fromPct(p.y2)}, {CURVE_ONE,CURVE_ONE} };
+    built[axis] = makePiecewise(k);
+  }
+  lut[axis] = built[axis].data();
+}
+void curveCompileAll(){ for(uint8_t i=0;i<AX_COUNT;i++) curveCompile(i); }
+void curveSetDefaults(){
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    curveId[i] = CURVE_DEFAULT;
+    curveParam[i] = { CURVE_EXPO_PCT_DEFAULT, 50, 20, 75, 50 };   // cassures : comme "zone fine"
+  }
+  curveCompileAll();
+}
+
+static inline int32_t lutEval(const uint16_t* t, int32_t x){
+  if(x<=0) return 0;
+  if(x>=CURVE_ONE) return CURVE_ONE;
+  const int32_t STEP = CURVE_ONE/CURVE_SEGS;
+  int32_t i=x/STEP, f=x%STEP;
+  return t[i] + ((int32_t)(t[i+1]-t[i])*f)/STEP;
+}
+
+// Débattement (0..span) → 0..CURVE_ONE → courbe → retour en points
+static inline int32_t shapeSide(const uint16_t* t, int32_t d, int32_t span){
+  if(span<=0) return d;
+  return (lutEval(t, d*CURVE_ONE/span)*span + CURVE_ONE/2)/CURVE_ONE;
+}
+
+int curveShape(uint8_t axis, int val, int lo, int nLo, int nHi, int hi){
+  const uint16_t* t = (axis<AX_COUNT)? lut[axis] : nullptr;
+  if(!t) return val;
+  if(val < nLo) return nLo - shapeSide(t, nLo-val, nLo-lo);
+  if(val > nHi) return nHi + shapeSide(t, val-nHi, hi-nHi);
+  return val;
+}
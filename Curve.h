@@ -0,0 +1,31 @@
+// Curve.h — Courbes de réponse par axe (table d'interpolation entière)
+#pragma once
+#include "Config.h"
+#include "Bridage.h"
+
+// Courbe appliquée de chaque côté du neutre : débattement 0..CURVE_ONE → 0..CURVE_ONE.
+// Préréglages générés à la compilation (constexpr, voir Curve.cpp), utilisés en place.
+// Courbes réglables : CURVE_EXPO (taux d'expo) et CURVE_KNEES (deux points de cassure),
+// construites dans la table RAM de l'axe par curveCompile() à chaque changement de réglage.
+enum CurveId : uint8_t { CURVE_LINEAR=0, CURVE_EXPO_SOFT, CURVE_EXPO_STRONG, CURVE_S, CURVE_FINE,
+                         CURVE_EXPO, CURVE_KNEES, CURVE_COUNT };
+
+// Réglages en % : expo 0 = linéaire, 100 = cubique pure ; cassures (x1,y1) et (x2,y2)
+// en % de la course / de la commande, x1 < x2, y1 <= y2 (sinon corrigés à la compilation).
+struct CurveParam { uint8_t expo, x1, y1, x2, y2; };
+
+#define CURVE_ONE    1024
+#define CURVE_SEGS   16
+#define CURVE_POINTS (CURVE_SEGS+1)
+
+extern uint8_t curveId[AX_COUNT];
+extern CurveParam curveParam[AX_COUNT];
+
+void curveSetDefaults();
+void curveCompile(uint8_t axis);   // à appeler après modification de curveId[axis] / curveParam[axis]
+void curveCompileAll();
+const char* curveName(uint8_t id);
+
+// Remet en forme val (points d'axe) entre les butées et la fenêtre neutre.
+// Courbe linéaire : val inchangée (chemin historique exact).
+int curveShape(uint8_t axis, int val, int lo, int nLo, int nHi, int hi);
@@ -3,7 +3,9 @@
 
 #include <Arduino.h>
 #include "Config.h"
+#include "Hal.h"
 #include "IOMap.h"
+#include "EffConfig.h"
 #include "Controllers.h"
 #include "Calibration.h"
 #include "Bridage.h"
@@ -11,64 +13,96 @@
 #include "FaultsPortal.h"
 #include "Portal.h"
 #include "Led.h"
+#include "Log.h"
+#include "Bench.h"
+#include "Latency.h"
+#include "Console.h"
+#include "Telemetry.h"
+#include "CmdQueue.h"
+#include "I2cSched.h"
+#include "Trace.h"
+#include "Power.h"
 
 static bool lastWired = false;
 
 void setup() {
   Serial.begin(115200);
   delay(200);
+  logBegin();              // journal asynchrone (vidé par une tâche basse priorité)
 
   pinMode(LED_VERTE_PIN, OUTPUT);
   pinMode(LED_ROUGE_PIN, OUTPUT);
   pinMode(GPIO_MANETTE_CONNECTEE, OUTPUT);
   pinMode(MODE_SEL_PIN, INPUT);
   pinMode(CAL_BTN_PIN, INPUT);
+  latMarkerBegin();
 
   ledSelfTest();
 
   ioInitI2CAndPCA();       // I2C + ADS + PCA (neutralise les sorties au passage)
   faultsBootCheck();       // Auto-test I2C (N2/N3/N4/N5 si besoin)
   calLoadOrDefault();      // Calibration joysticks (EEPROM)
+  loadNeutralOffset();     // avant le bridage (migration des bornes EEPROM < 0x0004)
   bridageLoadOrDefault();  // Bridage manette (EEPROM)
-  loadNeutralOffset();
-  updateNeutralWindow();
+  effCfgRebuild();         // première configuration effective (EffConfig.h)
   controllersSetup();      // Bluepad32 (callbacks connect/disconnect)
+  telemetryBegin();        // UDP (si TELEMETRY_ENABLE)
 
   // Mode initial + neutralisation
   lastWired = isWiredMode();
   onModeChanged(lastWired);
+  powerBegin();            // repos basse consommation (Power.h)
 
-  Serial.println("=== ESP32 PVG32 Controller prêt ===");
+#if BENCH_ENABLE
+  benchRun();
+#endif
+
+  controllersBootDone();   // chronologie mise sous tension → armé (console "pad", /status.json)
+  LOGI(LT_SYS, "=== ESP32 PVG32 Controller prêt ===");
 }
 
 void loop() {
+  loopTickBegin();
+  { TRACE_SCOPE(TR_CMD); cmdApplyPending(); }   // commandes du portail, appliquées entre deux tours
+
   // 1) Manette
-  controllersUpdate();
-  processR1L1Override();
-  processControllers();
+  { TRACE_SCOPE(TR_PAD);
+    controllersUpdate();
+    processR1L1Override();
+    processControllers(); }
 
   // 2) Joystick (et calibration intégrée)
-  processADS();
+  { TRACE_SCOPE(TR_ADS); processADS(); }
 
   // 3) Bridage: séquence 5 appuis + portail
-  bridageHandleButtonSequence(false, 50, 5000);
-  bridageHandlePortal();
+  { TRACE_SCOPE(TR_BRIDAGE);
+    bridageHandleButtonSequence(false, 50, 5000);
+    bridageHandlePortal(); }
 
   // 4) Défauts / Portail défaut
-  faultsPortalHandle();
-  portalHandle();
+  { TRACE_SCOPE(TR_PORTAL);
+    faultsPortalHandle();
+    portalHandle(); }
 
   // 5) Watchdog + LEDs
-  i2cRuntimeWatchdog();
-  serviceControllerLEDs();
-  updateStatusLEDs();
+  { TRACE_SCOPE(TR_SERVICE);
+    i2cRuntimeWatchdog();   // sondes mises en file (diagnostic)
+    serviceControllerLEDs();
+    updateStatusLEDs();
+    consoleHandle(); }
 
   // 6) Changement de mode via sectionneur
   bool wiredNow = isWiredMode();
-  if (wiredNow != lastWired && millis() > modeChangeBlockUntil) {
+  if (wiredNow != lastWired && halMillis() > modeChangeBlockUntil) {
+    powerActivity(PWR_INPUT, halMicros());
     onModeChanged(wiredNow);
     lastWired = wiredNow;
   }
 
-  delay(5);
+  i2cService();             // diagnostic I2C, après le dernier commit du tour
+  powerUpdate();            // régime rapide / repos pour l'attente qui suit
+  loopTickEnd();            // temps de boucle + télémétrie
+
+  // Attente de fin de tick : un rapport manette qui arrive ici est appliqué sans attendre
+  { TRACE_SCOPE(TR_WAIT); controllersWaitEvents(); }
 }
@@ -0,0 +1,79 @@
+// EffConfig.cpp — Configuration effective : instantané immuable publié par échange de pointeur
+#include "EffConfig.h"
+#include "IOMap.h"
+#include "Calibration.h"
+#include "Bridage.h"
+#include "Log.h"
+
+#define MAP_MIN 255
+#define MAP_MAX 768
+#define PAD_NEUTRAL_HALF_WINDOW 30
+// Rapports cycliques cibles : 25 % (min), 50 % (neutre), 75 % (max)
+#define DUTY_SPAN_HALF 0.25f
+
+static EffectiveConfig bufs[2];
+std::atomic<const EffectiveConfig*> effCfgLive{&bufs[0]};
+static uint32_t version = 0;
+
+static inline int clampInt(int v,int lo,int hi){ return (v<lo)? lo : (v>hi)? hi : v; }
+static inline uint64_t inv40(int32_t d){ return (1ULL<<40) / (uint64_t)d + 1; }
+static inline float dutySlope(int span){ return (span > 0)? DUTY_SPAN_HALF / (float)span : 0.0f; }
+static DutyCoef dutyCoef(int nLo, int nHi){ return { nLo, nHi, dutySlope(nLo - MAP_MIN), dutySlope(MAP_MAX - nHi) }; }
+
+static EffectiveConfig* inactive(){
+  return (effCfgLive.load(std::memory_order_relaxed) == &bufs[0])? &bufs[1] : &bufs[0];
+}
+
+static void build(EffectiveConfig& c){
+  c.version = ++version;
+  int off = neutralOffset;
+  c.neutralOffset = off;
+  c.mapMin = MAP_MIN; c.mapMax = MAP_MAX;
+  c.joyNeutralMin = off - JOY_NEUTRAL_HALF_WINDOW;
+  c.joyNeutralMax = off + JOY_NEUTRAL_HALF_WINDOW;
+  c.offsetDuty = -((float)off - 512.0f) / 512.0f * DUTY_SPAN_HALF;
+
+  int delta = off - 512;
+  for(int i=0;i<AX_COUNT;i++){
+    c.joyNeutralMinAx[i] = off - calNeutralHalf[i];
+    c.joyNeutralMaxAx[i] = off + calNeutralHalf[i];
+
+    CalAxis k = cal[i];
+    if(k.maxV<=k.midV) k.maxV=k.midV+1;
+    if(k.minV>=k.midV) k.minV=k.midV-1;
+    c.cal[i] = k;
+    c.joy[i] = { inv40(k.midV - k.minV), inv40(k.maxV - k.midV) };
+    c.duty[0][i] = dutyCoef(c.joyNeutralMin, c.joyNeutralMax);
+    c.duty[1][i] = dutyCoef(c.joyNeutralMinAx[i], c.joyNeutralMaxAx[i]);
+
+    for(int q=0;q<BRIDAGE_PROFILES;q++){
+      PadAxisCoef& p = c.padProf[q][i];
+      p.lo = clampInt(padMapMin[q][i] + delta, 0, 1023);
+      p.hi = clampInt(padMapMax[q][i] + delta, 0, 1023);
+      p.n  = (p.lo + p.hi) / 2;
+      p.span = p.hi - p.lo;
+      p.dNeg = p.lo - p.n; p.dPos = p.hi - p.n;
+      p.nLo = p.n - PAD_NEUTRAL_HALF_WINDOW; p.nHi = p.n + PAD_NEUTRAL_HALF_WINDOW;
+    }
+  }
+  c.profile = bridageProfile;
+  c.pad = c.padProf[c.profile];
+}
+
+void effCfgRebuild(){
+  EffectiveConfig* next = inactive();
+  build(*next);
+  effCfgLive.store(next, std::memory_order_release);
+  LOGD(LT_MAP, "configuration effective v%lu (offset %d)", (unsigned long)next->version, next->neutralOffset);
+}
+
+// Nouvelle version => les PadFrame en cache sont recalculées à la trame suivante
+void effCfgSelectProfile(uint8_t p){
+  EffectiveConfig* next = inactive();
+  *next = effCfg();
+  next->version = ++version;
+  next->profile = p;
+  next->pad = next->padProf[p];
+  effCfgLive.store(next, std::memory_order_release);
+  LOGD(LT_MAP, "configuration effective v%lu (profil %u)", (unsigned long)next->version, (unsigned)p);
+}
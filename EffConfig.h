@@ -0,0 +1,51 @@
+// EffConfig.h — Configuration effective : instantané immuable publié par échange de pointeur
+#pragma once
+#include "Config.h"
+#include "Axes.h"
+#include <atomic>
+
+// Sources (modifiées seulement par la boucle : démarrage, calibration, CmdQueue) :
+//   cal[] + calNeutralHalf[] (Calibration), padMapMin/Max (Bridage, bornes
+//   saisies au neutre 512, une ligne par profil), neutralOffset.
+// Tout ce qui en dérive est calculé une fois par effCfgRebuild() dans le tampon
+// inactif, puis publié d'un seul store(release). Le chemin chaud lit effCfg()
+// une fois par trame et ne voit jamais un mélange ancien/nouveau.
+// Tous les profils de bridage sont précalculés : en changer (effCfgSelectProfile)
+// ne fait que recopier l'instantané et déplacer le pointeur pad.
+// Deux tampons suffisent : la reconstruction a lieu sur la tâche de contrôle,
+// entre deux trames, et aucun lecteur ne garde l'instantané d'un tour à l'autre.
+
+struct CalAxis { int16_t minV, midV, maxV; };
+
+// Manette — lo/hi : bornes ; n : neutre ; span = hi-lo (sticks) ;
+// dNeg/dPos : n→lo et n→hi (gâchettes). nLo/nHi : fenêtre d'armement.
+struct PadAxisCoef { int32_t lo, hi, n, span, dNeg, dPos, nLo, nHi; };
+
+// Joysticks — inverses des écarts min→mid et mid→max en virgule fixe (2^40/écart + 1) :
+// (raw-min)·257·kLo >> 40 donne exactement map(raw,min,mid,255,512), sans division.
+struct JoyCoef { uint64_t kLo, kHi; };
+
+// Sorties — fenêtre neutre et pente du rapport cyclique de chaque côté (par point MAP) ;
+// indice 0 = manette (fenêtre commune), 1 = joysticks (fenêtre de l'axe)
+struct DutyCoef { int nLo, nHi; float kLo, kHi; };
+
+struct EffectiveConfig {
+  uint32_t version;                      // change à chaque publication
+  int      neutralOffset;
+  int      mapMin, mapMax;               // plage MAP des axes (255..768)
+  int      joyNeutralMin, joyNeutralMax; // fenêtre commune (manette)
+  int      joyNeutralMinAx[AX_COUNT], joyNeutralMaxAx[AX_COUNT];   // par axe (joysticks, calNeutralHalf)
+  float    offsetDuty;                   // décalage PWM dû à neutralOffset
+  CalAxis  cal[AX_COUNT];                // calibration assainie (min < mid < max)
+  JoyCoef  joy[AX_COUNT];                // pentes de mapJoy (cal[] ci-dessus)
+  DutyCoef duty[2][AX_COUNT];            // [filaire][axe], voir applyAxisToPair()
+  PadAxisCoef padProf[BRIDAGE_PROFILES][AX_COUNT];   // bridage décalé de neutralOffset, par profil
+  const PadAxisCoef* pad;                // padProf[profile] (dans ce même tampon)
+  uint8_t  profile;
+};
+
+extern std::atomic<const EffectiveConfig*> effCfgLive;
+
+inline const EffectiveConfig& effCfg(){ return *effCfgLive.load(std::memory_order_acquire); }
+void effCfgRebuild();   // à appeler après toute modification d'une source (jamais depuis une route HTTP)
+void effCfgSelectProfile(uint8_t p);   // republie l'instantané courant avec pad = padProf[p], sans recalcul
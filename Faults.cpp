@@ -1,13 +1,16 @@
 #include "Faults.h"
-#include <Wire.h>
 #include "Led.h"
 #include "IOMap.h"
+#include "Acq.h"
+#include "I2cSched.h"
 #include "Controllers.h"
 #include "Calibration.h"
 #include "FaultsPortal.h"
+#include "Log.h"
 
 volatile uint8_t faultCode = FC_NONE;
 bool missADSg=false, missADSd=false, missPCA=false;
+static bool missBusADS=false, missBusPCA=false;   // aucune carte ne répond sur le bus
 
 const unsigned long MODE_CHANGE_BLOCK_MS = 500;
 unsigned long modeChangeBlockUntil = 0;
@@ -15,11 +18,21 @@ unsigned long modeChangeBlockUntil = 0;
 static const uint32_t FAULT_BLINK_ON_MS=1000, FAULT_BLINK_OFF_MS=1000, FAULT_PAUSE_MS=4000;
 struct FaultDisplay { bool active=false; uint32_t t0=0; uint8_t state=0, blinkCount=0, blinkTarget=0; } fdisp;
 
-String fmtUptime(){ unsigned long s=millis()/1000UL; char b[16]; snprintf(b,sizeof(b),"%02lu:%02lu:%02lu",(s/3600UL)%100,(s%3600UL)/60UL,(s%60UL)); return String(b); }
+String fmtUptime(){ unsigned long s=halMillis()/1000UL; char b[16]; snprintf(b,sizeof(b),"%02lu:%02lu:%02lu",(s/3600UL)%100,(s%3600UL)/60UL,(s%60UL)); return String(b); }
 
 static void faultLEDOff(){ digitalWrite(LED_VERTE_PIN,false); digitalWrite(LED_ROUGE_PIN,false); }
-static void startFaultSeries(uint8_t n){ fdisp.active=true; fdisp.t0=millis(); fdisp.state=0; fdisp.blinkCount=0; fdisp.blinkTarget=n; digitalWrite(LED_VERTE_PIN,false); digitalWrite(LED_ROUGE_PIN, true); }
-static bool i2cExists(uint8_t addr){ Wire.beginTransmission(addr); return (Wire.endTransmission()==0); }
+static void startFaultSeries(uint8_t n){ fdisp.active=true; fdisp.t0=halMillis(); fdisp.state=0; fdisp.blinkCount=0; fdisp.blinkTarget=n; digitalWrite(LED_VERTE_PIN,false); digitalWrite(LED_ROUGE_PIN, true); }
+
+// Attribution au bus : toutes les cartes d'un bus muettes => câblage SDA/SCL plutôt que carte
+static const char* busDetail(){
+  if(HAL_I2C_BUSES < 2) return (missBusADS && missBusPCA)? " bus I2C muet" : "";
+  if(missBusADS && missBusPCA) return " bus ADS (Wire) et PCA (Wire1) muets";
+  if(missBusPCA) return " bus PCA (Wire1) muet";
+  if(missBusADS) return " bus ADS (Wire) muet";
+  return "";
+}
+
+const char* faultsBusDetail(){ return busDetail(); }
 
 // Séquence détaillée après N=5
 static uint8_t detailCycleIdx = 0;
@@ -36,22 +49,19 @@ static uint8_t pickNextI2CDetail(){
 void setFault(FaultCode c, const char* origin){
   if (faultCode == c) return;
   faultCode = c; fdisp.active = false;
-  Serial.printf("[DEFAUT %s] -> %u\n", origin, c);
+  LOGW(LT_DEFAUT, "%s -> %u", origin, c);
   if (c == FC_I2C_GENERAL){
-    Serial.print("N5 : Défaut général I2C. Détails :");
-    if(missADSd) Serial.print(" N2(ADS droit KO)");
-    if(missADSg) Serial.print(" N3(ADS gauche KO)");
-    if(missPCA)  Serial.print(" N4(PCA KO)");
-    Serial.println();
-  } else if (c == FC_ADS_DROIT)   Serial.println("N2 : ADS1115 DROIT (0x49) absent/KO.");
-  else if (c == FC_ADS_GAUCHE)    Serial.println("N3 : ADS1115 GAUCHE (0x48) absent/KO.");
-  else if (c == FC_PCA)           Serial.println("N4 : PCA9685 (0x40) absent/KO.");
+    LOGW(LT_DEFAUT, "N5 : Défaut général I2C. Détails :%s%s%s%s",
+         missADSd?" N2(ADS droit KO)":"", missADSg?" N3(ADS gauche KO)":"", missPCA?" N4(PCA KO)":"", busDetail());
+  } else if (c == FC_ADS_DROIT)   LOGW(LT_DEFAUT, "N2 : ADS1115 DROIT (0x49) absent/KO.");
+  else if (c == FC_ADS_GAUCHE)    LOGW(LT_DEFAUT, "N3 : ADS1115 GAUCHE (0x48) absent/KO.");
+  else if (c == FC_PCA)           LOGW(LT_DEFAUT, "N4 : PCA9685 (0x40) absent/KO.");
   else if (c == FC_NEUTRAL_TO) {
-    Serial.println("N7 : Temps dépassé pour neutre joystick au démarrage.");
+    LOGW(LT_DEFAUT, "N7 : Temps dépassé pour neutre joystick au démarrage.");
     // Afficher immédiatement les valeurs axes via le portail de calibration
     calibWifiStart();
   }
-  else if (c == FC_NO_GAMEPAD)    Serial.println("Alternance Rouge/Vert = Mode manette sans manette connectée.");
+  else if (c == FC_NO_GAMEPAD)    LOGW(LT_DEFAUT, "Alternance Rouge/Vert = Mode manette sans manette connectée.");
 
   if (faultCode != FC_NONE){
     faultsPortalStartAP();
@@ -59,7 +69,7 @@ void setFault(FaultCode c, const char* origin){
 }
 
 void clearFault(){
-  if(faultCode!=FC_NONE){ Serial.println("[DEFAUT] Effacement des défauts."); }
+  if(faultCode!=FC_NONE){ LOGI(LT_DEFAUT, "Effacement des défauts."); }
   faultCode=FC_NONE; fdisp.active=false;
   faultsPortalStopAP();
 }
@@ -73,10 +83,10 @@ void serviceFaultDisplay(){
   static bool last=false; static uint32_t t0=0;
   if (faultCode == FC_NEUTRAL_TO){
     bool now = readCalButton();   // <<< même logique que la calibration
-    if(now && !last){ t0 = millis(); }
+    if(now && !last){ t0 = halMillis(); }
     if(now && last){
-      if(millis()-t0 >= 5000){
-        Serial.println("[DEFAUT] Appui long détecté en N7 -> démarrage de la calibration.");
+      if(halMillis()-t0 >= 5000){
+        LOGI(LT_DEFAUT, "Appui long détecté en N7 -> démarrage de la calibration.");
         startCalibration();
         return;
       }
@@ -87,12 +97,12 @@ void serviceFaultDisplay(){
 
   if(faultCode==FC_NO_GAMEPAD){
     static uint32_t t=0; static bool flip=false;
-    if(millis()-t>=FAULT_BLINK_ON_MS){ t=millis(); flip=!flip; }
+    if(halMillis()-t>=FAULT_BLINK_ON_MS){ t=halMillis(); flip=!flip; }
     digitalWrite(LED_VERTE_PIN,flip); digitalWrite(LED_ROUGE_PIN,!flip);
     return;
   }
   if(!fdisp.active){ startFaultSeries((uint8_t)faultCode); }
-  uint32_t now=millis();
+  uint32_t now=halMillis();
   switch(fdisp.state){
     case 0: if(now-fdisp.t0>=FAULT_BLINK_ON_MS){ faultLEDOff(); fdisp.t0=now; fdisp.state=1; } break;
     case 1: if(now-fdisp.t0>=FAULT_BLINK_OFF_MS){
@@ -107,30 +117,45 @@ void serviceFaultDisplay(){
   }
 }
 
-void faultsBootCheck(){
-  auto exists=[&](uint8_t a){ Wire.beginTransmission(a); return Wire.endTransmission()==0; };
-  adsOK[0]=exists(0x48);
-  adsOK[1]=exists(0x49);
-  pcaOK   =exists(0x40);
-
-  missADSg=!adsOK[0]; missADSd=!adsOK[1]; missPCA=!pcaOK;
-
-  Serial.print("ADS GAUCHE @0x48 : "); Serial.println(adsOK[0]?"OK":"ERREUR");
-  Serial.print("ADS DROIT  @0x49 : "); Serial.println(adsOK[1]?"OK":"ERREUR");
-  Serial.print("PCA9685    @0x40 : "); Serial.println(pcaOK?"OK":"ABSENT");
-
-  if(!adsOK[0] || !adsOK[1] || !pcaOK) setFault(FC_I2C_GENERAL,"boot_i2c_check");
+// Sonde toutes les cartes de la table AXES ; ADS 2/3 et PCA supplémentaires
+// ne sont signalés que par le défaut général N5. Le CAN SPI remplace les deux
+// ADS : son absence est signalée N5 avec N2 + N3.
+static bool probeI2CDevices(){
+  bool acq = acqProbe();
+#if ACQ_BACKEND == ACQ_SPI_ADC
+  missADSg = missADSd = !acq;
+#else
+  (void)acq; missADSg=!adsOK[0]; missADSd=!adsOK[1];
+#endif
+  bool anyADS=false; for(uint8_t b=0;b<AXES_ADS_USED;b++) anyADS = anyADS || adsOK[b];
+  missBusADS = AXES_ADS_USED && !anyADS;
+  pcaOK=true; bool anyPCA=false;
+  for(uint8_t b=0;b<AXES_PCA_BOARDS;b++){ bool p = halI2CProbe(HAL_I2C_PCA, HAL_PCA_ADDR(b)); pcaOK = pcaOK && p; anyPCA = anyPCA || p; }
+  missPCA=!pcaOK; missBusPCA = AXES_PCA_BOARDS && !anyPCA;
+  return ioHardwareOK();
 }
 
-void i2cRuntimeWatchdog(){
-  static uint32_t last=0; if(millis()-last<2500) return; last=millis();
-  auto exists=[&](uint8_t a){ Wire.beginTransmission(a); return Wire.endTransmission()==0; };
-  bool newADSg=exists(0x48), newADSd=exists(0x49), newPCA=exists(0x40);
-  adsOK[0]=newADSg; adsOK[1]=newADSd; pcaOK=newPCA;
+void faultsBootCheck(){
+  bool ok = probeI2CDevices();
+
+#if ACQ_BACKEND == ACQ_SPI_ADC
+  LOGI(LT_I2C, "CAN SPI    CS%-4d : %s", ACQ_SPI_CS, acqAllOK()?"OK":"ERREUR");
+#else
+  LOGI(LT_I2C, "ADS GAUCHE @0x48 : %s", adsOK[0]?"OK":"ERREUR");
+  LOGI(LT_I2C, "ADS DROIT  @0x49 : %s", adsOK[1]?"OK":"ERREUR");
+#endif
+  for(uint8_t b=2;b<AXES_ADS_USED;b++) LOGI(LT_I2C, "ADS %u      @0x%02X : %s", b, HAL_ADS_ADDR(b), adsOK[b]?"OK":"ERREUR");
+  for(uint8_t b=0;b<AXES_PCA_BOARDS;b++){
+    bool p=halI2CProbe(HAL_I2C_PCA, HAL_PCA_ADDR(b));
+    LOGI(LT_I2C, "PCA9685    @0x%02X%s : %s", HAL_PCA_ADDR(b), HAL_I2C_PCA? " (Wire1)" : "", p?"OK":"ABSENT");
+  }
 
-  missADSg=!adsOK[0]; missADSd=!adsOK[1]; missPCA=!pcaOK;
+  if(!ok) setFault(FC_I2C_GENERAL,"boot_i2c_check");
+}
 
-  if(!adsOK[0] || !adsOK[1] || !pcaOK){
+// Sondes en priorité diagnostic (I2cSched.h) : exécutées après le commit du tour
+static void watchdogJob(){
+  if(!probeI2CDevices()){
     if(faultCode != FC_I2C_GENERAL) setFault(FC_I2C_GENERAL,"i2c_watchdog");
   } else {
     if(faultCode==FC_I2C_GENERAL || faultCode==FC_ADS_DROIT || faultCode==FC_ADS_GAUCHE || faultCode==FC_PCA){
@@ -138,3 +163,8 @@ void i2cRuntimeWatchdog(){
     }
   }
 }
+
+void i2cRuntimeWatchdog(){
+  static uint32_t last=0; if(halMillis()-last<2500) return; last=halMillis();
+  i2cPost(watchdogJob);
+}
@@ -8,5 +8,6 @@ void clearFault();
 void serviceFaultDisplay();
 void faultsBootCheck();
 void i2cRuntimeWatchdog();
+const char* faultsBusDetail();   // bus I2C muet(s) à la dernière sonde ; "" sinon
 bool isAnyControllerConnected();
 String fmtUptime();
@@ -4,6 +4,8 @@
 #include "Faults.h"        // faultCode, missADSg/missADSd/missPCA, fmtUptime()
 #include "Calibration.h"   // calibMode
 #include "Bridage.h"       // isBridageActive()
+#include "Controllers.h"   // chronologie démarrage → armé
+#include "Log.h"
 
 // Indique si la page défaut est enregistrée dans le serveur partagé
 static bool active = false;
@@ -137,7 +139,7 @@ static String htmlPage(){
 // -----------------------------------------------------------------------------
 static void onRoot(){ auto& server = portalServer(); server.send(200, "text/html", htmlPage()); }
 
-static void onStatus(){
+String faultsStatusJson(){
   String d = faultDetailText(faultCode); d.replace("\"","\\\"");
   String j = "{";
   j += "\"N\":" + String((int)faultCode);
@@ -148,15 +150,18 @@ static void onStatus(){
   if (faultCode==FC_ADS_GAUCHE || missADSg){ if(!first) j+=','; j += "\"ADS1115 GAUCHE (0x48)\""; }
   j += "]";
   j += ",\"module\":\"" + modulesHS() + "\"";
+  j += ",\"bus\":\"" + String(faultsBusDetail()) + "\"";
   j += ",\"missADSg\":" + String(missADSg ? "true" : "false");
   j += ",\"missADSd\":" + String(missADSd ? "true" : "false");
   j += ",\"missPCA\":"  + String(missPCA  ? "true" : "false");
   j += ",\"uptime\":\"" + fmtUptime() + "\"";
+  j += ",\"armTimeline\":" + controllersTimelineJson();
   j += "}";
-  auto& server = portalServer();
-  server.send(200, "application/json", j);
+  return j;
 }
 
+static void onStatus(){ auto& server = portalServer(); server.send(200, "application/json", faultsStatusJson()); }
+
 // -----------------------------------------------------------------------------
 // AP Start/Stop + loop
 // -----------------------------------------------------------------------------
@@ -172,14 +177,14 @@ void faultsPortalStartAP(){
   server.on("/status.json", HTTP_GET, onStatus);
 
   active = true;
-  Serial.println("[DEFAUT] Portail d\u00E9faut actif (AP partag\u00E9).");
+  LOGI(LT_DEFAUT, "Portail d\u00E9faut actif (AP partag\u00E9).");
 }
 
 void faultsPortalStopAP(){
   if (!active) return;
   portalStop();
   active = false;
-  Serial.println("[DEFAUT] Portail d\u00E9faut stopp\u00E9.");
+  LOGI(LT_DEFAUT, "Portail d\u00E9faut stopp\u00E9.");
 }
 
 void faultsPortalHandle(){ if (active) portalHandle(); }
@@ -13,3 +13,6 @@ void faultsPortalHandle();
 
 // Indique si le portail défaut est actif
 bool isFaultsPortalActive();
+
+// Corps JSON de /status.json
+String faultsStatusJson();
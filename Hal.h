@@ -0,0 +1,131 @@
+// Hal.h — Couche d'abstraction matérielle (horloge, GPIO, I2C, ADS1115, PCA9685, LEDC, SPI, manettes)
+#pragma once
+#include "Config.h"
+
+// Le code de contrôle (IOMap, Controllers, Calibration, Faults, Bridage) ne
+// touche plus directement Wire / Adafruit_* / Bluepad32 / millis() : il passe
+// par ces fonctions. Deux implémentations :
+//   - HalEsp32.cpp : matériel réel (HAL_SIM == 0, défaut)
+//   - HalSim.cpp   : périphériques simulés en mémoire + horloge virtuelle
+//                    (HAL_SIM == 1) — le firmware tourne sans ADS/PCA/manette,
+//                    de façon déterministe et plus vite que le temps réel.
+//                    Sous Linux : CMakeLists.txt (cibles pvg32_sim / pvg32_bench,
+//                    cœur Arduino et FreeRTOS minimaux dans host/).
+
+// ---------------- Horloge ----------------
+uint32_t halMillis();
+uint32_t halMicros();
+void     halDelay(uint32_t ms);
+void     halDelayUs(uint32_t us);   // attente courte active (aucune transaction de bus)
+
+// ---------------- GPIO ----------------
+int  halDigitalRead(uint8_t pin);
+void halDigitalWrite(uint8_t pin, bool level);
+
+// ---------------- I2C ----------------
+// Bus 0 = Wire (I2C_SDA/I2C_SCL) : ADS, et PCA en bus simple.
+// Bus 1 = Wire1 (I2C1_SDA/I2C1_SCL) : PCA si I2C_DUAL_BUS.
+#define HAL_I2C_ADS   0
+#define HAL_I2C_PCA   (I2C_DUAL_BUS? 1 : 0)
+#define HAL_I2C_BUSES (I2C_DUAL_BUS? 2 : 1)
+void halI2CBegin();
+bool halI2CProbe(uint8_t bus, uint8_t addr);    // true = ACK
+void halI2CBusStats(uint8_t bus, uint32_t& xfers, uint32_t& errors);   // depuis le démarrage
+
+// ---------------- ADS1115 (index 0 = 0x48 gauche, 1 = 0x49 droit, 2 = 0x4A, 3 = 0x4B) ----------------
+#define HAL_ADS_COUNT 4
+#define HAL_ADS_ADDR(idx) (uint8_t)(0x48 + (idx))
+bool    halAdsBegin(uint8_t idx, uint8_t addr);
+int16_t halAdsRead(uint8_t idx, uint8_t channel); // conversion simple bloquante
+// Conversion non bloquante : lancer sur plusieurs cartes, puis relire chacune.
+// Les conversions des différentes cartes se recouvrent.
+bool    halAdsStart(uint8_t idx, uint8_t channel);
+bool    halAdsReady(uint8_t idx);
+int16_t halAdsResult(uint8_t idx);
+
+// ---------------- PCA9685 (carte b = 0x40 + b, voie globale = b*16 + canal) ----------------
+#define HAL_PCA_COUNT 4
+#define HAL_PCA_ADDR(board) (uint8_t)(0x40 + (board))
+bool halPcaBegin(uint8_t board, uint8_t addr, float freqHz);
+// halPcaSet() n'écrit que dans un registre fantôme ; halPcaFlush() envoie, par carte,
+// les voies modifiées en une seule rafale I2C (auto-incrément), valeurs inchangées omises.
+// I2C_DUAL_BUS : halPcaFlush() confie la rafale à une tâche d'envoi sur Wire1 et rend la
+// main aussitôt (attente seulement si la rafale précédente est encore sur le bus).
+void halPcaSet(uint8_t ch, uint16_t on, uint16_t off);
+void halPcaFlush();
+uint16_t halPcaDuty(uint8_t ch);   // registre fantôme en pas 0..4096 (4096 = plein ON), pour la télémétrie
+
+// ---------------- LEDC + GPIO de sortie (OUTPUT_BACKEND == OUTPUT_LEDC) ----------------
+bool halLedcBegin(uint8_t pin, uint32_t freqHz, uint8_t bits);
+void halLedcWrite(uint8_t pin, uint32_t duty);   // duty = 2^bits : plein ON
+void halPinOutput(uint8_t pin);
+
+// ---------------- CAN SPI (ACQ_BACKEND == ACQ_SPI_ADC) ----------------
+// Hôte ACQ_SPI_HOST, broches ACQ_SPI_* (Config.h), mode 0, DMA. Une trame = n transactions
+// de 3 octets mises en file d'un coup (CS relâché entre chacune), relues ensuite.
+#define HAL_SPI_FRAME_MAX 8
+bool halSpiAdcBegin();
+bool halSpiAdcFrame(const uint8_t tx[][3], uint8_t rx[][3], uint8_t n);
+
+// ---------------- Alimentation (Power.h) ----------------
+// Repos : CPU à POWER_IDLE_CPU_MHZ (DFS esp_pm si CONFIG_PM_ENABLE, sinon setCpuFrequencyMhz),
+// APB maintenu à 80 MHz. Aucun sommeil léger (verrou PM du Bluetooth classique).
+void halPowerIdle(bool idle);
+
+// ---------------- Manettes ----------------
+#define HAL_PAD_SLOTS 4
+
+// Échantillon brut d'une manette (unités Bluepad32)
+struct PadSample {
+  int16_t  lx, ly, rx, ry;      // -512..511
+  int16_t  throttle, brake;     // 0..1023
+  uint8_t  dpad;                // PAD_DPAD_*
+  uint16_t buttons;
+  uint8_t  misc;                // PAD_MISC_*
+};
+// Masques de bits (valeurs Bluepad32)
+constexpr uint8_t PAD_DPAD_UP = 0x01, PAD_DPAD_DOWN = 0x02, PAD_DPAD_RIGHT = 0x04, PAD_DPAD_LEFT = 0x08;
+constexpr uint8_t PAD_MISC_SYSTEM = 0x01, PAD_MISC_SELECT = 0x02, PAD_MISC_START = 0x04;   // PS, SELECT/SHARE, START/OPTIONS
+
+typedef void (*HalPadEventCb)(uint8_t slot);
+
+void halPadSetup(HalPadEventCb onConnect, HalPadEventCb onDisconnect);
+bool halPadUpdate();                             // pompe la pile BT, true = nouvelles données
+bool halPadConnected(uint8_t slot);
+bool halPadRead(uint8_t slot, PadSample& out);   // false si slot vide
+void halPadSetColor(uint8_t slot, uint8_t r, uint8_t g, uint8_t b);
+bool halPadAddress(uint8_t slot, uint8_t addr[6]);   // adresse Bluetooth ; false si slot vide
+void halPadDisconnect(uint8_t slot);             // libère le slot tout de suite, sans rappel onDisconnect
+void halPadForgetKeys();                         // efface les manettes appairées (clés Bluetooth)
+void halPadForgetAddress(const uint8_t addr[6]); // efface la clé d'une seule manette
+// Filtrage à la connexion Bluetooth : une adresse hors liste n'est ni appairée
+// ni reconnectée (même appairée auparavant) ; n = 0 lève le filtre.
+void halPadSetAllowList(const uint8_t (*addrs)[6], uint8_t n);
+
+#if HAL_SIM
+// ---------------- Pilotage de la simulation ----------------
+void halSimAdvance(uint32_t us);                 // avance l'horloge virtuelle
+void halSimSetPin(uint8_t pin, bool level);      // entrée GPIO (sélecteur, bouton calib)
+void halSimSetDevice(uint8_t addr, bool present);// présence sur le bus I2C
+void halSimSetBusDown(uint8_t bus, bool down);   // bus entier muet (SDA/SCL coupés)
+void halSimSetAds(uint8_t idx, uint8_t ch, int16_t raw);
+void halSimSetAdsNoise(uint16_t peak);           // bruit uniforme ±peak ajouté à chaque conversion
+uint32_t halSimAdsPolls();                       // sondages halAdsReady() depuis le démarrage
+uint16_t halSimPcaOff(uint8_t ch);               // dernier registre OFF envoyé (après halPcaFlush)
+bool halSimPcaFullOn(uint8_t ch);
+uint32_t halSimPcaBursts();                      // rafales I2C émises depuis le démarrage
+uint32_t halSimPcaBusUs();                       // durée cumulée de ces rafales sur le bus PCA
+uint32_t halSimLedcDuty(uint8_t pin);            // dernier rapport LEDC écrit sur la broche
+uint32_t halSimLedcWrites();                     // écritures LEDC depuis le démarrage
+void halSimSetSpiAdc(uint8_t ch, uint16_t raw12);// voie du CAN SPI simulé (MCP3208)
+void halSimSetSpiAdcPresent(bool present);       // absent = MISO tiré haut (0xFF)
+uint32_t halSimSpiFrames();                      // trames SPI depuis le démarrage
+bool halSimPowerIdle();                          // dernier régime demandé par halPowerIdle()
+void halSimPadConnect(uint8_t slot);
+void halSimPadDisconnect(uint8_t slot);
+void halSimPadSet(uint8_t slot, const PadSample& s);
+void halSimPadSetAddress(uint8_t slot, const uint8_t addr[6]);   // adresse vue au prochain halSimPadConnect()
+uint32_t halSimPadKeysForgotten();               // appels à halPadForgetKeys() depuis le démarrage
+uint32_t halSimPadAddrForgotten();               // appels à halPadForgetAddress() depuis le démarrage
+uint32_t halSimPadBtRefused();                   // connexions écartées par la liste blanche Bluetooth
+#endif
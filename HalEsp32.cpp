@@ -0,0 +1,333 @@
+// HalEsp32.cpp — HAL matériel réel : Wire, Adafruit ADS1115/PCA9685, Bluepad32
+#include "Hal.h"
+#include "Trace.h"
+#if !HAL_SIM
+#include <Wire.h>
+#include <Adafruit_ADS1X15.h>
+#include <Adafruit_PWMServoDriver.h>
+#include <Bluepad32.h>
+#include <uni.h>          // liste blanche Bluepad32, clés BTstack
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <sdkconfig.h>
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+
+static_assert(HAL_PAD_SLOTS <= BP32_MAX_GAMEPADS, "HAL_PAD_SLOTS > BP32_MAX_GAMEPADS");
+
+// ---------------- Horloge / GPIO ----------------
+uint32_t halMillis(){ return millis(); }
+uint32_t halMicros(){ return micros(); }
+void     halDelay(uint32_t ms){ delay(ms); }
+void     halDelayUs(uint32_t us){ delayMicroseconds(us); }
+
+int  halDigitalRead(uint8_t pin){ return digitalRead(pin); }
+void halDigitalWrite(uint8_t pin, bool level){ digitalWrite(pin, level); }
+
+// ---------------- I2C ----------------
+#if I2C_DUAL_BUS
+static void pcaTxStart();
+#endif
+
+void halI2CBegin(){
+#if defined(ARDUINO_ARCH_ESP32)
+  Wire.begin(I2C_SDA,I2C_SCL);
+#else
+  Wire.begin();
+#endif
+  Wire.setClock(400000);
+#if I2C_DUAL_BUS
+  Wire1.begin(I2C1_SDA, I2C1_SCL);
+  Wire1.setClock(400000);
+  pcaTxStart();
+#endif
+}
+
+static uint32_t busXfers[HAL_I2C_BUSES], busErrors[HAL_I2C_BUSES];
+
+// Wire/Wire1 sont verrouillés par le cœur Arduino : sonde et tâche d'envoi peuvent se croiser
+bool halI2CProbe(uint8_t bus, uint8_t addr){
+  if(bus>=HAL_I2C_BUSES) return false;
+  TwoWire& w = bus? Wire1 : Wire;
+  w.beginTransmission(addr);
+  bool ok = (w.endTransmission()==0);
+  busXfers[bus]++; if(!ok) busErrors[bus]++;
+  return ok;
+}
+void halI2CBusStats(uint8_t bus, uint32_t& xfers, uint32_t& errors){
+  xfers  = (bus<HAL_I2C_BUSES)? busXfers[bus]  : 0;
+  errors = (bus<HAL_I2C_BUSES)? busErrors[bus] : 0;
+}
+
+// ---------------- ADS1115 ----------------
+static Adafruit_ADS1115 ads[HAL_ADS_COUNT];
+
+bool halAdsBegin(uint8_t idx, uint8_t addr){
+  if(idx>=HAL_ADS_COUNT || !ads[idx].begin(addr)) return false;
+  ads[idx].setGain(GAIN_TWOTHIRDS);
+  uint16_t rate;
+  switch(ADS_DATA_RATE_SPS){
+    case 8:   rate=RATE_ADS1115_8SPS;   break;
+    case 16:  rate=RATE_ADS1115_16SPS;  break;
+    case 32:  rate=RATE_ADS1115_32SPS;  break;
+    case 64:  rate=RATE_ADS1115_64SPS;  break;
+    case 250: rate=RATE_ADS1115_250SPS; break;
+    case 475: rate=RATE_ADS1115_475SPS; break;
+    case 860: rate=RATE_ADS1115_860SPS; break;
+    default:  rate=RATE_ADS1115_128SPS; break;
+  }
+  ads[idx].setDataRate(rate);
+  return true;
+}
+
+int16_t halAdsRead(uint8_t idx, uint8_t channel){
+  return (idx<HAL_ADS_COUNT)? ads[idx].readADC_SingleEnded(channel) : 0;
+}
+
+static const uint16_t ADS_MUX[4] = {
+  ADS1X15_REG_CONFIG_MUX_SINGLE_0, ADS1X15_REG_CONFIG_MUX_SINGLE_1,
+  ADS1X15_REG_CONFIG_MUX_SINGLE_2, ADS1X15_REG_CONFIG_MUX_SINGLE_3
+};
+
+bool halAdsStart(uint8_t idx, uint8_t channel){
+  if(idx>=HAL_ADS_COUNT || channel>=4) return false;
+  ads[idx].startADCReading(ADS_MUX[channel], /*continuous=*/false);
+  return true;
+}
+bool    halAdsReady(uint8_t idx){ return idx<HAL_ADS_COUNT && ads[idx].conversionComplete(); }
+int16_t halAdsResult(uint8_t idx){ return (idx<HAL_ADS_COUNT)? ads[idx].getLastConversionResults() : 0; }
+
+// ---------------- PCA9685 ----------------
+// Adafruit_PWMServoDriver ne sert qu'à l'init (reset, fréquence, auto-incrément) ;
+// les sorties partent en rafale depuis les registres fantômes.
+#define PCA_LED0_ON_L 0x06
+struct PcaBoard { Adafruit_PWMServoDriver* drv; uint8_t addr; uint16_t dirty; uint16_t on[16], off[16]; };
+static PcaBoard pcaBoards[HAL_PCA_COUNT];
+
+bool halPcaBegin(uint8_t board, uint8_t addr, float freqHz){
+  if(board>=HAL_PCA_COUNT) return false;
+  PcaBoard& b = pcaBoards[board];
+  if(!b.drv) b.drv = new Adafruit_PWMServoDriver(addr, HAL_I2C_PCA? Wire1 : Wire);
+  b.addr = addr;
+  b.drv->begin(); b.drv->setPWMFreq(freqHz);
+  for(int c=0;c<16;c++){ b.on[c]=0xFFFF; b.off[c]=0xFFFF; }   // force le premier envoi
+  b.dirty = 0;
+  return true;
+}
+
+void halPcaSet(uint8_t ch, uint16_t on, uint16_t off){
+  PcaBoard& b = pcaBoards[(ch>>4) % HAL_PCA_COUNT];
+  uint8_t c = ch & 15;
+  if(!b.drv || ch>=HAL_PCA_COUNT*16 || (b.on[c]==on && b.off[c]==off)) return;
+  b.on[c]=on; b.off[c]=off; b.dirty |= (1u<<c);
+}
+
+// Rafales figées au commit : la tâche d'envoi (bus double) ne lit jamais les registres fantômes
+struct PcaBurst { uint8_t addr, first, last; uint16_t on[16], off[16]; };
+static PcaBurst bursts[HAL_PCA_COUNT];
+static uint8_t nBursts = 0;
+
+static void sendBursts(){
+  TwoWire& w = HAL_I2C_PCA? Wire1 : Wire;
+  for(uint8_t k=0;k<nBursts;k++){
+    const PcaBurst& p = bursts[k];
+    w.beginTransmission(p.addr);
+    w.write((uint8_t)(PCA_LED0_ON_L + 4*p.first));
+    for(uint8_t c=p.first;c<=p.last;c++){
+      w.write((uint8_t)p.on[c]);  w.write((uint8_t)(p.on[c]>>8));
+      w.write((uint8_t)p.off[c]); w.write((uint8_t)(p.off[c]>>8));
+    }
+    busXfers[HAL_I2C_PCA]++;
+    if(w.endTransmission()!=0) busErrors[HAL_I2C_PCA]++;
+  }
+  nBursts = 0;
+}
+
+#if I2C_DUAL_BUS
+static TaskHandle_t pcaTx = nullptr;
+static SemaphoreHandle_t pcaIdle = nullptr;   // libre = aucune rafale en cours
+static void pcaTxTask(void*){
+  for(;;){
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t t0 = halMicros(); sendBursts(); traceSpan(TR_PCA_TX, t0);
+    xSemaphoreGive(pcaIdle);
+  }
+}
+// Même cœur que loop(), priorité au-dessus : la tâche part dès le commit et rend le
+// processeur pendant le transfert (attente sur interruption I2C)
+static void pcaTxStart(){
+  if(pcaTx) return;
+  pcaIdle = xSemaphoreCreateBinary(); xSemaphoreGive(pcaIdle);
+  xTaskCreatePinnedToCore(pcaTxTask, "pcaTx", 2048, nullptr, tskIDLE_PRIORITY+3, &pcaTx, ARDUINO_RUNNING_CORE);
+}
+#endif
+
+void halPcaFlush(){
+#if I2C_DUAL_BUS
+  xSemaphoreTake(pcaIdle, portMAX_DELAY);
+#endif
+  for(uint8_t k=0;k<HAL_PCA_COUNT;k++){
+    PcaBoard& b = pcaBoards[k];
+    if(!b.dirty) continue;
+    PcaBurst& p = bursts[nBursts++];
+    p.addr = b.addr; p.first = __builtin_ctz(b.dirty); p.last = 31 - __builtin_clz(b.dirty);
+    for(uint8_t c=p.first;c<=p.last;c++){ p.on[c]=b.on[c]; p.off[c]=b.off[c]; }
+    b.dirty = 0;
+  }
+#if I2C_DUAL_BUS
+  if(nBursts) xTaskNotifyGive(pcaTx); else xSemaphoreGive(pcaIdle);
+#else
+  sendBursts();
+#endif
+}
+
+uint16_t halPcaDuty(uint8_t ch){
+  if(ch>=HAL_PCA_COUNT*16) return 0;
+  const PcaBoard& b = pcaBoards[ch>>4]; uint8_t c = ch & 15;
+  return (b.on[c] & 4096)? 4096 : (b.off[c] & 4096)? 0 : b.off[c];
+}
+
+// ---------------- LEDC + GPIO de sortie ----------------
+bool halLedcBegin(uint8_t pin, uint32_t freqHz, uint8_t bits){ return ledcAttach(pin, freqHz, bits); }
+void halLedcWrite(uint8_t pin, uint32_t duty){ ledcWrite(pin, duty); }
+void halPinOutput(uint8_t pin){ pinMode(pin, OUTPUT); }
+
+// ---------------- Alimentation ----------------
+// Plancher 80 MHz au repos : APB (I2C, LEDC) inchangé. Actif : fréquence fixe (min = max).
+// Pas de sommeil léger : le Bluetooth classique garde son verrou PM tant qu'il est actif.
+void halPowerIdle(bool idle){
+  static uint32_t fullMhz = 0;
+  if(!fullMhz) fullMhz = getCpuFrequencyMhz();
+  uint32_t mhz = idle? POWER_IDLE_CPU_MHZ : fullMhz;
+#if CONFIG_PM_ENABLE
+  esp_pm_config_t pm = {};
+  pm.max_freq_mhz = (int)mhz;
+  pm.min_freq_mhz = idle? 80 : (int)mhz;
+  pm.light_sleep_enable = false;
+  if(esp_pm_configure(&pm) == ESP_OK) return;
+#endif
+  setCpuFrequencyMhz(mhz);
+}
+
+// ---------------- CAN SPI (pilote IDF spi_master, DMA) ----------------
+// Tampons DMA statiques ; le bus est pris une fois par trame, les n transactions sont
+// mises en file d'un coup puis relues : pas d'attente CPU entre deux conversions.
+static spi_device_handle_t spiAdc = nullptr;
+static spi_transaction_t spiTrans[HAL_SPI_FRAME_MAX];
+static WORD_ALIGNED_ATTR uint8_t spiTx[HAL_SPI_FRAME_MAX][4], spiRx[HAL_SPI_FRAME_MAX][4];
+
+bool halSpiAdcBegin(){
+  if(spiAdc) return true;
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num = ACQ_SPI_MOSI; bus.miso_io_num = ACQ_SPI_MISO; bus.sclk_io_num = ACQ_SPI_SCK;
+  bus.quadwp_io_num = -1; bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = 4;
+  if(spi_bus_initialize((spi_host_device_t)ACQ_SPI_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) return false;
+  spi_device_interface_config_t dev = {};
+  dev.clock_speed_hz = ACQ_SPI_CLOCK_HZ; dev.mode = 0;
+  dev.spics_io_num = ACQ_SPI_CS; dev.queue_size = HAL_SPI_FRAME_MAX;
+  if(spi_bus_add_device((spi_host_device_t)ACQ_SPI_HOST, &dev, &spiAdc) != ESP_OK){ spiAdc = nullptr; return false; }
+  gpio_pullup_en((gpio_num_t)ACQ_SPI_MISO);   // CAN absent => 0xFF, bit nul à 1
+  for(uint8_t k=0;k<HAL_SPI_FRAME_MAX;k++){
+    spiTrans[k] = {}; spiTrans[k].length = 24;
+    spiTrans[k].tx_buffer = spiTx[k]; spiTrans[k].rx_buffer = spiRx[k];
+  }
+  return true;
+}
+
+bool halSpiAdcFrame(const uint8_t tx[][3], uint8_t rx[][3], uint8_t n){
+  if(!spiAdc || n>HAL_SPI_FRAME_MAX) return false;
+  if(spi_device_acquire_bus(spiAdc, portMAX_DELAY) != ESP_OK) return false;
+  bool ok = true; uint8_t queued = 0;
+  for(; queued<n; queued++){
+    memcpy(spiTx[queued], tx[queued], 3);
+    if(spi_device_queue_trans(spiAdc, &spiTrans[queued], 0) != ESP_OK){ ok = false; break; }
+  }
+  // Chaque transaction en file doit être rendue avant spi_device_release_bus() :
+  // après un premier dépassement, la trame est perdue mais la file est vidée sans délai.
+  for(uint8_t k=0;k<queued;){
+    spi_transaction_t* done;
+    if(spi_device_get_trans_result(spiAdc, &done, ok? pdMS_TO_TICKS(5) : portMAX_DELAY) == ESP_OK) k++;
+    else ok = false;
+  }
+  spi_device_release_bus(spiAdc);
+  if(ok) for(uint8_t k=0;k<n;k++) memcpy(rx[k], spiRx[k], 3);
+  return ok;
+}
+
+// ---------------- Manettes (Bluepad32) ----------------
+static ControllerPtr pads[HAL_PAD_SLOTS];
+static HalPadEventCb cbConnect = nullptr, cbDisconnect = nullptr;
+
+static void onBpConnected(ControllerPtr ctl){
+  for(uint8_t i=0;i<HAL_PAD_SLOTS;i++) if(!pads[i]){ pads[i]=ctl; if(cbConnect) cbConnect(i); return; }
+}
+
+static void onBpDisconnected(ControllerPtr ctl){
+  for(uint8_t i=0;i<HAL_PAD_SLOTS;i++) if(pads[i]==ctl){ pads[i]=nullptr; if(cbDisconnect) cbDisconnect(i); return; }
+}
+
+void halPadSetup(HalPadEventCb onConnect, HalPadEventCb onDisconnect){
+  cbConnect=onConnect; cbDisconnect=onDisconnect;
+  BP32.setup(&onBpConnected,&onBpDisconnected);
+}
+
+void halPadForgetKeys(){ BP32.forgetBluetoothKeys(); }
+
+// Clé d'une manette : BTstack n'est pas réentrant, l'effacement part sur sa tâche.
+// Une demande à la fois ; une manette refusée entre-temps le sera de nouveau.
+static bd_addr_t forgetAddr;
+static btstack_context_callback_registration_t forgetReg;
+static volatile bool forgetPending = false;
+static void forgetOnBtThread(void*){ gap_drop_link_key_for_bd_addr(forgetAddr); forgetPending = false; }
+
+void halPadForgetAddress(const uint8_t addr[6]){
+  if(forgetPending) return;
+  forgetPending = true;
+  memcpy(forgetAddr, addr, 6);
+  forgetReg.callback = &forgetOnBtThread; forgetReg.context = nullptr;
+  btstack_run_loop_execute_on_main_thread(&forgetReg);
+}
+
+// Liste blanche de Bluepad32 (persistée en NVS) : la pile refuse l'adresse avant
+// appairage comme à la reconnexion d'une manette déjà appairée.
+void halPadSetAllowList(const uint8_t (*addrs)[6], uint8_t n){
+  uni_bt_allowlist_remove_all();
+  for(uint8_t k=0;k<n;k++){ bd_addr_t a; memcpy(a, addrs[k], 6); uni_bt_allowlist_add_addr(a); }
+  uni_bt_allowlist_set_enabled(n > 0);
+}
+
+bool halPadUpdate(){ return BP32.update(); }
+
+bool halPadConnected(uint8_t slot){ return slot<HAL_PAD_SLOTS && pads[slot] && pads[slot]->isConnected(); }
+
+bool halPadRead(uint8_t slot, PadSample& out){
+  if(!halPadConnected(slot)) return false;
+  ControllerPtr c = pads[slot];
+  out.lx=c->axisX(); out.ly=c->axisY(); out.rx=c->axisRX(); out.ry=c->axisRY();
+  out.throttle=c->throttle(); out.brake=c->brake();
+  out.dpad=c->dpad(); out.buttons=c->buttons(); out.misc=c->miscButtons();
+  return true;
+}
+
+void halPadSetColor(uint8_t slot, uint8_t r, uint8_t g, uint8_t b){ if(halPadConnected(slot)) pads[slot]->setColorLED(r,g,b); }
+
+bool halPadAddress(uint8_t slot, uint8_t addr[6]){
+  if(!halPadConnected(slot)) return false;
+  ControllerProperties p = pads[slot]->getProperties();
+  memcpy(addr, p.btaddr, 6);
+  return true;
+}
+
+// Slot libéré avant la fin de la déconnexion : onBpDisconnected() ne le retrouvera pas
+void halPadDisconnect(uint8_t slot){
+  if(slot>=HAL_PAD_SLOTS || !pads[slot]) return;
+  ControllerPtr c = pads[slot]; pads[slot] = nullptr;
+  c->disconnect();
+}
+
+#endif
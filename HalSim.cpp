@@ -0,0 +1,246 @@
+// HalSim.cpp — HAL simulée : périphériques en mémoire + horloge virtuelle
+#include "Hal.h"
+#include "Axes.h"
+#if HAL_SIM
+
+// Horloge virtuelle : n'avance que par halDelay()/halSimAdvance(), donc une
+// séquence d'entrées donnée produit toujours la même séquence de sorties.
+static uint64_t simUs = 0;
+
+uint32_t halMillis(){ return (uint32_t)(simUs/1000ULL); }
+uint32_t halMicros(){ return (uint32_t)simUs; }
+void     halDelay(uint32_t ms){ simUs += (uint64_t)ms*1000ULL; }
+void     halDelayUs(uint32_t us){ simUs += us; }
+void     halSimAdvance(uint32_t us){ simUs += us; }
+
+// ---------------- GPIO ----------------
+static bool pinLevel[40];
+
+int  halDigitalRead(uint8_t pin){ return (pin<40 && pinLevel[pin])? HIGH : LOW; }
+void halDigitalWrite(uint8_t pin, bool level){ if(pin<40) pinLevel[pin]=level; }
+void halSimSetPin(uint8_t pin, bool level){ if(pin<40) pinLevel[pin]=level; }
+
+// ---------------- I2C ----------------
+// Par défaut les cartes câblées par la table AXES répondent (câblage nominal)
+static bool devPresent[128];
+static bool busDown[HAL_I2C_BUSES];
+static uint32_t busXfers[HAL_I2C_BUSES], busErrors[HAL_I2C_BUSES];
+
+// Adresses PCA (0x40 + carte) sur le bus PCA, le reste sur le bus ADS
+static inline uint8_t busOf(uint8_t addr){ return (addr>=HAL_PCA_ADDR(0) && addr<HAL_PCA_ADDR(HAL_PCA_COUNT))? HAL_I2C_PCA : HAL_I2C_ADS; }
+
+void halI2CBegin(){   // autres cartes : halSimSetDevice()
+  for(uint8_t b=0;b<axesAdsUsed();b++) devPresent[HAL_ADS_ADDR(b)]=true;
+  for(uint8_t b=0;b<axesPcaBoards();b++) devPresent[HAL_PCA_ADDR(b)]=true;
+}
+bool halI2CProbe(uint8_t bus, uint8_t addr){
+  if(bus>=HAL_I2C_BUSES || addr>=128) return false;
+  bool ok = devPresent[addr] && !busDown[bus] && busOf(addr)==bus;
+  busXfers[bus]++; if(!ok) busErrors[bus]++;
+  return ok;
+}
+void halI2CBusStats(uint8_t bus, uint32_t& xfers, uint32_t& errors){
+  xfers  = (bus<HAL_I2C_BUSES)? busXfers[bus]  : 0;
+  errors = (bus<HAL_I2C_BUSES)? busErrors[bus] : 0;
+}
+void halSimSetDevice(uint8_t addr, bool present){ if(addr<128) devPresent[addr]=present; }
+void halSimSetBusDown(uint8_t bus, bool down){ if(bus<HAL_I2C_BUSES) busDown[bus]=down; }
+
+// ---------------- ADS1115 ----------------
+// Neutre ≈ moitié de la pleine échelle tant que la simulation ne fixe rien
+static int16_t adsRaw[HAL_ADS_COUNT][4] = {
+  {16384,16384,16384,16384},{16384,16384,16384,16384},{16384,16384,16384,16384},{16384,16384,16384,16384}
+};
+static const uint32_t ADS_XFER_US = 150;    // une transaction I2C (lancement ou relecture)
+static const uint32_t ADS_CONV_US = 1000000UL/ADS_DATA_RATE_SPS + ADS_XFER_US;
+static uint16_t adsNoise = 0;               // bruit crête simulé (±, pas brut)
+static uint32_t noiseRng = 0x9E3779B9u;
+static int16_t noisy(int16_t v){
+  if(!adsNoise) return v;
+  noiseRng ^= noiseRng<<13; noiseRng ^= noiseRng>>17; noiseRng ^= noiseRng<<5;
+  int32_t n = (int32_t)(noiseRng % (2u*adsNoise+1)) - adsNoise;
+  int32_t r = v + n; return (int16_t)(r<0? 0 : r>32767? 32767 : r);
+}
+struct SimAdsConv { uint8_t ch; uint64_t readyAt; };
+static SimAdsConv adsConv[HAL_ADS_COUNT];
+
+bool halAdsBegin(uint8_t idx, uint8_t addr){ return idx<HAL_ADS_COUNT && halI2CProbe(HAL_I2C_ADS, addr); }
+
+int16_t halAdsRead(uint8_t idx, uint8_t channel){
+  if(idx>=HAL_ADS_COUNT || channel>=4) return 0;
+  simUs += ADS_CONV_US;
+  return noisy(adsRaw[idx][channel]);
+}
+
+bool halAdsStart(uint8_t idx, uint8_t channel){
+  if(idx>=HAL_ADS_COUNT || channel>=4) return false;
+  simUs += ADS_XFER_US;
+  adsConv[idx] = { channel, simUs + ADS_CONV_US - ADS_XFER_US };
+  return true;
+}
+// Chaque sondage est une transaction I2C (relecture du registre de configuration)
+static uint32_t adsPolls = 0;
+bool halAdsReady(uint8_t idx){
+  if(idx>=HAL_ADS_COUNT) return true;
+  adsPolls++; simUs += ADS_XFER_US;
+  return simUs >= adsConv[idx].readyAt;
+}
+uint32_t halSimAdsPolls(){ return adsPolls; }
+int16_t halAdsResult(uint8_t idx){
+  if(idx>=HAL_ADS_COUNT) return 0;
+  simUs += ADS_XFER_US;
+  return noisy(adsRaw[idx][adsConv[idx].ch]);
+}
+void halSimSetAdsNoise(uint16_t peak){ adsNoise = peak; }
+
+void halSimSetAds(uint8_t idx, uint8_t ch, int16_t raw){ if(idx<HAL_ADS_COUNT && ch<4) adsRaw[idx][ch]=raw; }
+
+// ---------------- PCA9685 ----------------
+// shadow = écrit par halPcaSet() ; reg = envoyé par halPcaFlush() (vu par les vannes)
+struct SimPcaReg { uint16_t on, off; };
+static const uint8_t PCA_CH = HAL_PCA_COUNT*16;
+static SimPcaReg pcaShadow[PCA_CH], pcaReg[PCA_CH];
+static uint8_t pcaDirty[HAL_PCA_COUNT*2];   // 1 bit par voie
+static uint32_t pcaBursts = 0;
+static uint64_t pcaBusUs = 0;               // durée cumulée des rafales
+
+bool halPcaBegin(uint8_t board, uint8_t addr, float){ return board<HAL_PCA_COUNT && halI2CProbe(HAL_I2C_PCA, addr); }
+void halPcaSet(uint8_t ch, uint16_t on, uint16_t off){
+  if(ch>=PCA_CH || (pcaShadow[ch].on==on && pcaShadow[ch].off==off)) return;
+  pcaShadow[ch]={on,off}; pcaDirty[ch>>3] |= (1u<<(ch&7));
+}
+// Durée d'une rafale à 400 kHz : adresse + registre + 4 octets par voie (9 bits/octet)
+static const uint32_t I2C_BYTE_US = 23, I2C_FRAME_US = 30;
+#if I2C_DUAL_BUS
+static uint64_t pcaBusyUntil = 0;           // fin de la rafale en cours sur Wire1
+#endif
+void halPcaFlush(){
+  uint32_t cost = 0;
+  for(uint8_t b=0;b<HAL_PCA_COUNT;b++){
+    int8_t first=-1, last=-1;
+    for(uint8_t c=b*16;c<b*16+16;c++) if(pcaDirty[c>>3] & (1u<<(c&7))){ pcaReg[c]=pcaShadow[c]; if(first<0) first=c; last=c; }
+    pcaDirty[b*2]=pcaDirty[b*2+1]=0;
+    if(first>=0){ pcaBursts++; busXfers[HAL_I2C_PCA]++; cost += I2C_FRAME_US + (2 + 4*(last-first+1))*I2C_BYTE_US; }
+  }
+  if(!cost) return;
+  pcaBusUs += cost;
+#if I2C_DUAL_BUS
+  if(simUs < pcaBusyUntil) simUs = pcaBusyUntil;   // rafale précédente pas finie
+  pcaBusyUntil = simUs + cost;
+  simUs += 5;                                      // remise à la tâche d'envoi
+#else
+  simUs += cost;
+#endif
+}
+uint16_t halPcaDuty(uint8_t ch){
+  if(ch>=PCA_CH) return 0;
+  return (pcaShadow[ch].on & 4096)? 4096 : (pcaShadow[ch].off & 4096)? 0 : pcaShadow[ch].off;
+}
+uint16_t halSimPcaOff(uint8_t ch){ return (ch<PCA_CH)? pcaReg[ch].off : 0; }
+bool halSimPcaFullOn(uint8_t ch){ return ch<PCA_CH && (pcaReg[ch].on & 4096); }
+uint32_t halSimPcaBursts(){ return pcaBursts; }
+uint32_t halSimPcaBusUs(){ return (uint32_t)pcaBusUs; }
+
+// ---------------- LEDC + GPIO de sortie ----------------
+// Faux enregistreur : dernier rapport par broche + nombre d'écritures
+static uint32_t ledcDuty[40];
+static uint32_t ledcWrites = 0;
+
+bool halLedcBegin(uint8_t pin, uint32_t, uint8_t){ return pin<40; }
+void halLedcWrite(uint8_t pin, uint32_t duty){ if(pin<40){ ledcDuty[pin]=duty; ledcWrites++; } }
+void halPinOutput(uint8_t){}
+uint32_t halSimLedcDuty(uint8_t pin){ return (pin<40)? ledcDuty[pin] : 0; }
+uint32_t halSimLedcWrites(){ return ledcWrites; }
+
+// ---------------- CAN SPI ----------------
+// Modèle MCP3208 : commande START|SGL|D2, D1 D0, réponse bit nul puis 12 bits.
+// Transaction de 24 bits à ACQ_SPI_CLOCK_HZ + délai CS/DMA ; absent = MISO tiré haut.
+static uint16_t spiAdc[8] = {2048,2048,2048,2048,2048,2048,2048,2048};
+static bool spiPresent = true;
+static uint32_t spiFrames = 0;
+static const uint32_t SPI_XFER_US = 24000000UL/ACQ_SPI_CLOCK_HZ + 2;
+static const uint32_t SPI_FRAME_US = 15;   // mise en file + relecture des résultats
+
+bool halSpiAdcBegin(){ return true; }
+bool halSpiAdcFrame(const uint8_t tx[][3], uint8_t rx[][3], uint8_t n){
+  if(n>HAL_SPI_FRAME_MAX) return false;
+  for(uint8_t k=0;k<n;k++){
+    if(!spiPresent || (tx[k][0] & 0x06) != 0x06){ rx[k][0]=rx[k][1]=rx[k][2]=0xFF; continue; }
+    uint8_t ch = ((tx[k][0] & 1) << 2) | (tx[k][1] >> 6);
+    uint16_t v = (uint16_t)(noisy((int16_t)(spiAdc[ch] << 3)) >> 3);
+    rx[k][0]=0xFF; rx[k][1]=(uint8_t)(0xE0 | (v>>8)); rx[k][2]=(uint8_t)v;   // bit 4 = bit nul
+  }
+  simUs += SPI_FRAME_US + (uint64_t)n*SPI_XFER_US;
+  spiFrames++;
+  return true;
+}
+void halSimSetSpiAdc(uint8_t ch, uint16_t raw12){ if(ch<8) spiAdc[ch] = raw12 & 0x0FFF; }
+void halSimSetSpiAdcPresent(bool present){ spiPresent = present; }
+uint32_t halSimSpiFrames(){ return spiFrames; }
+
+// ---------------- Alimentation ----------------
+static bool powerIdle = false;
+void halPowerIdle(bool idle){ powerIdle = idle; }
+bool halSimPowerIdle(){ return powerIdle; }
+
+// ---------------- Manettes ----------------
+struct SimPad { bool connected; bool fresh; PadSample s; uint8_t addr[6]; };
+static SimPad pads[HAL_PAD_SLOTS];
+static HalPadEventCb cbConnect = nullptr, cbDisconnect = nullptr;
+static uint8_t pendingConnect = 0, pendingDisconnect = 0;   // masques de slots
+static uint32_t keysForgotten = 0, addrForgotten = 0, btRefused = 0;
+static uint8_t allowAddr[PAD_ALLOW_MAX][6], allowN = 0;
+
+static bool btAllowed(const uint8_t a[6]){
+  if(!allowN) return true;
+  for(uint8_t k=0;k<allowN;k++) if(!memcmp(allowAddr[k], a, 6)) return true;
+  return false;
+}
+
+void halPadSetup(HalPadEventCb onConnect, HalPadEventCb onDisconnect){ cbConnect=onConnect; cbDisconnect=onDisconnect; }
+
+// Les événements sont livrés depuis halPadUpdate(), comme Bluepad32 le fait depuis BP32.update()
+bool halPadUpdate(){
+  bool fresh=false;
+  for(uint8_t i=0;i<HAL_PAD_SLOTS;i++){
+    if(pendingDisconnect & (1u<<i)){ pads[i].connected=false; if(cbDisconnect) cbDisconnect(i); }
+    if(pendingConnect & (1u<<i)){
+      if(!btAllowed(pads[i].addr)) btRefused++;   // écartée par la pile, jamais vue par l'appli
+      else { pads[i].connected=true; if(cbConnect) cbConnect(i); }
+    }
+    if(pads[i].fresh){ pads[i].fresh=false; fresh=true; }
+  }
+  pendingConnect=pendingDisconnect=0;
+  return fresh;
+}
+
+bool halPadConnected(uint8_t slot){ return slot<HAL_PAD_SLOTS && pads[slot].connected; }
+
+bool halPadRead(uint8_t slot, PadSample& out){
+  if(!halPadConnected(slot)) return false;
+  out=pads[slot].s; return true;
+}
+
+void halPadSetColor(uint8_t, uint8_t, uint8_t, uint8_t){}
+
+bool halPadAddress(uint8_t slot, uint8_t addr[6]){
+  if(!halPadConnected(slot)) return false;
+  memcpy(addr, pads[slot].addr, 6); return true;
+}
+void halPadDisconnect(uint8_t slot){ if(slot<HAL_PAD_SLOTS){ pads[slot].connected=false; pendingDisconnect &= ~(1u<<slot); } }
+void halPadForgetKeys(){ keysForgotten++; }
+void halPadForgetAddress(const uint8_t*){ addrForgotten++; }
+void halPadSetAllowList(const uint8_t (*addrs)[6], uint8_t n){
+  allowN = (n < PAD_ALLOW_MAX)? n : PAD_ALLOW_MAX;
+  for(uint8_t k=0;k<allowN;k++) memcpy(allowAddr[k], addrs[k], 6);
+}
+
+void halSimPadConnect(uint8_t slot){ if(slot<HAL_PAD_SLOTS){ pads[slot].s=PadSample{}; pendingConnect|=(1u<<slot); } }
+void halSimPadDisconnect(uint8_t slot){ if(slot<HAL_PAD_SLOTS) pendingDisconnect|=(1u<<slot); }
+void halSimPadSet(uint8_t slot, const PadSample& s){ if(slot<HAL_PAD_SLOTS){ pads[slot].s=s; pads[slot].fresh=true; } }
+void halSimPadSetAddress(uint8_t slot, const uint8_t addr[6]){ if(slot<HAL_PAD_SLOTS) memcpy(pads[slot].addr, addr, 6); }
+uint32_t halSimPadKeysForgotten(){ return keysForgotten; }
+uint32_t halSimPadAddrForgotten(){ return addrForgotten; }
+uint32_t halSimPadBtRefused(){ return btRefused; }
+
+#endif
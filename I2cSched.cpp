@@ -0,0 +1,85 @@
+// I2cSched.cpp — Ordonnanceur du bus I2C : sorties, puis acquisition, puis diagnostic
+#include "I2cSched.h"
+#include "Hal.h"
+#include "Log.h"
+#include "Trace.h"
+
+struct I2cStat { uint32_t n; uint64_t busy, wait; uint32_t busyMax, waitMax; };
+static I2cStat stats[I2C_CLASSES];
+static uint32_t winStartUs = 0;
+static int8_t active = -1;                 // classe en cours, -1 = bus libre
+static uint32_t activeT0 = 0, activeWait = 0;
+static uint32_t conflicts = 0, dropped = 0;
+
+struct Pending { I2cJob job; uint32_t tPost; };
+static Pending fifo[I2C_SCHED_DEPTH];
+static uint8_t nPending = 0;
+
+static const char* const CLASS_NAMES[I2C_CLASSES] = { "commit", "scan", "diag" };
+static_assert((int)TR_I2C_SAMPLE == TR_I2C_COMMIT + (int)I2C_SAMPLE && (int)TR_I2C_DIAG == TR_I2C_COMMIT + (int)I2C_DIAG,
+              "Trace : ordre des classes I2C");
+
+void i2cBegin(I2cClass c){
+  if(active >= 0) conflicts++;             // imbrication : ne doit pas arriver
+  active = c; activeT0 = halMicros();
+}
+
+void i2cEnd(){
+  if(active < 0) return;
+  I2cStat& s = stats[active];
+  uint32_t busy = halMicros() - activeT0;
+  s.n++; s.busy += busy; s.wait += activeWait;
+  if(busy > s.busyMax) s.busyMax = busy;
+  if(activeWait > s.waitMax) s.waitMax = activeWait;
+  traceSpan((TraceId)(TR_I2C_COMMIT + active), activeT0);
+  active = -1; activeWait = 0;
+}
+
+bool i2cPost(I2cJob job){
+  for(uint8_t k=0;k<nPending;k++) if(fifo[k].job == job) return true;
+  if(nPending >= I2C_SCHED_DEPTH){ dropped++; return false; }
+  fifo[nPending++] = { job, halMicros() };
+  return true;
+}
+
+// Seules les demandes présentes à l'entrée passent : une tâche qui se reposte attend le tour suivant.
+// Au moins une par tour, pour ne jamais bloquer le diagnostic.
+void i2cService(){
+  uint8_t n = nPending;
+  uint32_t t0 = halMicros();
+  for(uint8_t k=0;k<n;k++){
+    if(k && halMicros()-t0 >= I2C_DIAG_BUDGET_US) break;
+    Pending p = fifo[0];
+    nPending--;
+    for(uint8_t j=0;j<nPending;j++) fifo[j] = fifo[j+1];
+    i2cBegin(I2C_DIAG);
+    activeWait = halMicros() - p.tPost;
+    p.job();
+    i2cEnd();
+  }
+}
+
+uint32_t i2cWaitMaxUs(I2cClass c){ return (c < I2C_CLASSES)? stats[c].waitMax : 0; }
+uint32_t i2cConflicts(){ return conflicts + dropped; }
+
+void i2cStatsReset(){ memset(stats, 0, sizeof(stats)); winStartUs = halMicros(); conflicts = dropped = 0; }
+
+void i2cStatsPrint(){
+  uint32_t win = halMicros() - winStartUs;
+  uint64_t busy = 0; for(const auto& s:stats) busy += s.busy;
+  LOGI(LT_I2C, "bus : occupation %lu.%lu %% sur %lu ms, file diag %u/%u, refus %lu, conflits %lu",
+       (unsigned long)(win? busy*1000/win/10 : 0), (unsigned long)(win? busy*1000/win%10 : 0),
+       (unsigned long)(win/1000), (unsigned)nPending, (unsigned)I2C_SCHED_DEPTH,
+       (unsigned long)dropped, (unsigned long)conflicts);
+  for(uint8_t b=0;b<HAL_I2C_BUSES;b++){
+    uint32_t x, e; halI2CBusStats(b, x, e);
+    LOGI(LT_I2C, "%-6s : %lu sondes/rafales, %lu erreur(s)", b? "Wire1" : "Wire", (unsigned long)x, (unsigned long)e);
+  }
+  for(uint8_t c=0;c<I2C_CLASSES;c++){
+    const I2cStat& s = stats[c];
+    if(!s.n){ LOGI(LT_I2C, "%-6s : aucune transaction", CLASS_NAMES[c]); continue; }
+    LOGI(LT_I2C, "%-6s : n=%lu occupé moy=%lu max=%lu us, attente moy=%lu max=%lu us", CLASS_NAMES[c],
+         (unsigned long)s.n, (unsigned long)(s.busy/s.n), (unsigned long)s.busyMax,
+         (unsigned long)(s.wait/s.n), (unsigned long)s.waitMax);
+  }
+}
@@ -0,0 +1,29 @@
+// I2cSched.h — Ordonnanceur du bus I2C : sorties, puis acquisition, puis diagnostic
+#pragma once
+#include "Config.h"
+
+// Le bus n'est utilisé que depuis la tâche de contrôle (loop), par ordre de priorité :
+//   I2C_COMMIT : rafale PCA9685 (outCommit), dès qu'une trame de sortie est prête
+//   I2C_SAMPLE : scan ADS du chemin de contrôle (readADSRaw)
+//   I2C_DIAG   : sondes du watchdog, lectures du portail et de la console ; mises en
+//                file par i2cPost(), exécutées par i2cService() en fin de tour, après
+//                le dernier commit, dans un budget de I2C_DIAG_BUDGET_US
+// COMMIT et SAMPLE sont synchrones : i2cBegin()/i2cEnd() les encadrent pour la mesure.
+// Une tâche de diagnostic ne doit pas attendre le bus : elle se reposte si besoin.
+// Init matérielle et auto-test de setup() : accès direct, avant la première boucle.
+// I2C_DUAL_BUS : COMMIT ne mesure que la remise à la tâche d'envoi (Wire1), le scan
+// suivant sur Wire se déroule pendant la rafale.
+
+#define I2C_SCHED_DEPTH 4
+
+enum I2cClass : uint8_t { I2C_COMMIT=0, I2C_SAMPLE, I2C_DIAG, I2C_CLASSES };
+typedef void (*I2cJob)();
+
+void i2cBegin(I2cClass c);
+void i2cEnd();
+bool i2cPost(I2cJob job);       // déjà en file = ignoré ; false si file pleine
+void i2cService();              // fin de tour (loop)
+void i2cStatsReset();
+void i2cStatsPrint();           // occupation du bus, temps d'occupation et d'attente par classe
+uint32_t i2cWaitMaxUs(I2cClass c);   // attente max depuis i2cStatsReset()
+uint32_t i2cConflicts();              // imbrications + refus de file depuis i2cStatsReset()
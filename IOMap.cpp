@@ -3,45 +3,26 @@
 #include "Faults.h"
 #include "Calibration.h"
 #include "Bridage.h"
-#include <Wire.h>
+#include "Log.h"
+#include "Latency.h"
+#include "PadMap.h"
+#include "Ramp.h"
+#include "Curve.h"
+#include "Output.h"
+#include "Acq.h"
+#include "I2cSched.h"
+#include "Trace.h"
+#include "Power.h"
 #include <EEPROM.h>
 
-/* Mapping from PWM input channels to TOR channels (per user wiring)
-   PWM indexes 0 to 7 map to TOR indexes 9,8,10,11,12,13,14,15. */
-static const uint8_t PWM_TO_TOR[8] = {9,8,10,11,12,13,14,15};
+// ADS index i = 0x48+i (0 gauche, 1 droit) ; PCA9685 carte b = 0x40+b (voir Hal.h / Axes.h)
+bool pcaOK=true;                  // toutes les cartes PCA utilisées
+bool adsOK[HAL_ADS_COUNT]={false};
+int neutralOffset=512;      // source ; valeurs dérivées : effCfg() (EffConfig.h)
 
-
-Adafruit_ADS1115 ads_gnd; // 0x48
-Adafruit_ADS1115 ads_vdd; // 0x49
-Adafruit_PWMServoDriver pca = Adafruit_PWMServoDriver(0x40);
-
-bool pcaOK=true;
-bool adsOK[2]={false,false};
-int neutralOffset=512;
-int joyNeutralMin=0, joyNeutralMax=0;
-static int mapMin=255, mapMax=768;
-
-static const int NEUTRAL_HALF_WINDOW = 30;
-static int lastOffset = 512;
+static const int NEUTRAL_HALF_WINDOW = JOY_NEUTRAL_HALF_WINDOW;
 #define EE_NEUTRAL_OFFSET_ADDR 200
 
-void updateNeutralWindow(){
-  joyNeutralMin = neutralOffset - NEUTRAL_HALF_WINDOW;
-  joyNeutralMax = neutralOffset + NEUTRAL_HALF_WINDOW;
-
-  int delta = neutralOffset - lastOffset;
-  if(delta != 0){
-    for(int i=0;i<AX_COUNT;i++){
-      padMapMin[i] += delta;
-      padMapMax[i] += delta;
-      padNeutral[i] += delta;
-      padNeutralMin[i] += delta;
-      padNeutralMax[i] += delta;
-    }
-    lastOffset = neutralOffset;
-  }
-}
-
 void loadNeutralOffset(){
 #if defined(ARDUINO_ARCH_ESP32)
   EEPROM.begin(512);
@@ -50,7 +31,6 @@ void loadNeutralOffset(){
   EEPROM.get(EE_NEUTRAL_OFFSET_ADDR, v);
   if(v>1023) v=512;
   neutralOffset = (int)v;
-  lastOffset = neutralOffset;
 }
 
 void saveNeutralOffset(){
@@ -60,64 +40,109 @@ void saveNeutralOffset(){
   uint16_t v = (uint16_t)neutralOffset;
   EEPROM.put(EE_NEUTRAL_OFFSET_ADDR, v);
 #if defined(ARDUINO_ARCH_ESP32)
-  EEPROM.commit();
+  { TRACE_SCOPE(TR_FLASH); EEPROM.commit(); }
 #endif
 }
 
-CalAxis cal[8];
+CalAxis cal[AX_COUNT];
 
-static bool i2cExists(uint8_t addr){ Wire.beginTransmission(addr); return (Wire.endTransmission()==0); }
+bool isAxisAvailable(uint8_t axisIndex){ return acqAxisOK(axisIndex); }
 
-static const AxisConfig AXIS_MAP[8] = {
-  {1,2,false}, {1,1,false}, {1,0,false}, {0,1,false},
-  {0,2,true }, {0,0,true }, {1,3,true }, {0,3,true }
-};
+bool ioHardwareOK(){ return acqAllOK() && pcaOK; }
 
-bool isAxisAvailable(uint8_t axisIndex){
-  if(axisIndex>=8) return false;
-  uint8_t adsIdx = AXIS_MAP[axisIndex].adsIndex;
-  return adsOK[adsIdx];
-}
+// ---------------- Mesure du bruit (brut filtré, par axe) ----------------
+struct NoiseStat { uint32_t n; int16_t mn, mx; int64_t sum, sumSq; };
+static NoiseStat noise[AX_COUNT];
+static void adsNoiseAccumulate(const ADSRaw& r);
+
+static ADSRaw lastRaw{};
 
-static inline int16_t readAxisRawOne(const AxisConfig& cfg){
-  int16_t v=16384;
-  if(cfg.adsIndex==0){ if(adsOK[0]) v=ads_gnd.readADC_SingleEnded(cfg.channel); }
-  else { if(adsOK[1]) v=ads_vdd.readADC_SingleEnded(cfg.channel); }
-  return cfg.inverted? (int16_t)(32767 - v) : v;
+// Brut du convertisseur (Acq.h) puis inversion selon la table AXES
+static inline void applyInversion(ADSRaw& r){
+  axesForEach([&](auto ax){
+    constexpr uint8_t i = decltype(ax)::value;
+    if constexpr (AXES[i].inverted) r.v[i] = (int16_t)(32767 - r.v[i]);
+  });
 }
 
 ADSRaw readADSRaw(){
-  ADSRaw r{}; int16_t* p=(int16_t*)&r;
-  for(int i=0;i<8;i++) p[i]=readAxisRawOne(AXIS_MAP[i]);
+  ADSRaw r{};
+  acqScan(r);
+  applyInversion(r);
+  adsNoiseAccumulate(r);
+  lastRaw = r;
   return r;
 }
 
-int mapADSWithCal(int16_t raw,const CalAxis& c){
-  int16_t mn=c.minV, md=c.midV, mx=c.maxV; if(mx<=md) mx=md+1; if(mn>=md) mn=md-1;
-  if(raw<=md){ if(raw<mn) raw=mn; return map(raw,mn,md,255,512); }
-  else       { if(raw>mx) raw=mx; return map(raw,md,mx,512,768); }
+const ADSRaw& adsLastRaw(){ return lastRaw; }
+
+// Relecture de diagnostic, un axe par tour (I2cSched.h) ; hors mesure de bruit (pas de suréchantillonnage)
+static ADSRaw diagRaw{};
+static void diagSampleJob(){
+  if(!acqDiagStep(diagRaw)){ i2cPost(diagSampleJob); return; }
+  applyInversion(diagRaw);
+  lastRaw = diagRaw;
 }
 
-Axes8 mapADSAll(const ADSRaw& r){
-  Axes8 a{};
-  a.X = mapADSWithCal(r.X,cal[0]); a.Y = mapADSWithCal(r.Y,cal[1]); a.Z = mapADSWithCal(r.Z,cal[2]);
-  a.LX= mapADSWithCal(r.LX,cal[3]); a.LY= mapADSWithCal(r.LY,cal[4]); a.LZ= mapADSWithCal(r.LZ,cal[5]);
-  a.R1= mapADSWithCal(r.R1,cal[6]); a.R2= mapADSWithCal(r.R2,cal[7]);
-
-  int *v = (int*)&a;
-  for(int i=0;i<8;i++){
-    if(v[i] < mapMin) v[i] = mapMin;
-    if(v[i] > mapMax) v[i] = mapMax;
+const ADSRaw& adsDiagRaw(){
+  if(halMicros() - lastRaw.tAcqUs[AX_COUNT-1] > ADS_DIAG_MAX_AGE_MS*1000UL || !lastRaw.tAcqUs[AX_COUNT-1])
+    i2cPost(diagSampleJob);
+  return lastRaw;
+}
+
+void adsNoiseReset(){ memset(noise, 0, sizeof(noise)); }
+
+static void adsNoiseAccumulate(const ADSRaw& r){
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    NoiseStat& s = noise[i]; int16_t v = r.v[i];
+    if(!s.n || v<s.mn) s.mn=v;
+    if(!s.n || v>s.mx) s.mx=v;
+    s.n++; s.sum += v; s.sumSq += (int64_t)v*v;
   }
-  return a;
 }
 
-static inline float mapf(float x,float in_min,float in_max,float out_min,float out_max){
-  if(in_max==in_min) return out_min;
-  float r=(x-in_min)/(in_max-in_min);
-  if(r<0) r=0;
-  if(r>1) r=1;
-  return out_min + r*(out_max-out_min);
+// Points MAP par pas brut autour du neutre (pente de mapADSWithCal côté haut)
+static float mapPerRaw(uint8_t i){ int d = cal[i].maxV - cal[i].midV; return d>0? 256.0f/(float)d : 0.0f; }
+
+void adsNoisePrint(){
+  LOGI(LT_MAP, "bruit (axes immobiles) : %u SPS x%u, fenêtre neutre ±%d", (unsigned)ADS_DATA_RATE_SPS, (unsigned)ADS_OVERSAMPLE, NEUTRAL_HALF_WINDOW);
+  LOGI(LT_MAP, "axe       n  crête(brut) sigma(brut)  crête(MAP) sigma(MAP) neutre(calib)");
+  float worstPP = 0;
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    const NoiseStat& s = noise[i];
+    if(s.n<2) continue;
+    float mean = (float)s.sum / s.n;
+    float var  = (float)s.sumSq / s.n - mean*mean; if(var<0) var=0;
+    float sd = sqrtf(var), pp = (float)(s.mx - s.mn), k = mapPerRaw(i);
+    if(pp*k > worstPP) worstPP = pp*k;
+    LOGI(LT_MAP, "%-3u %8lu %12.0f %11.1f %11.2f %10.2f %9s±%u", i, (unsigned long)s.n, pp, sd, pp*k, sd*k, "", calNeutralHalf[i]);
+  }
+  // Demi-fenêtre = crête-crête le plus large (2× la demi-crête) + 2 points pour la dérive/arrondi
+  LOGI(LT_MAP, "demi-fenêtre minimale conseillée : ±%d (JOY_NEUTRAL_HALF_WINDOW)", (int)ceilf(worstPP) + 2);
+}
+
+// Référence (hors chemin chaud) : calibration quelconque, assainie ici
+int mapADSWithCal(int16_t raw,const CalAxis& c){
+  CalAxis k=c; if(k.maxV<=k.midV) k.maxV=k.midV+1; if(k.minV>=k.midV) k.minV=k.midV-1;
+  if(raw<=k.midV){ if(raw<k.minV) raw=k.minV; return map(raw,k.minV,k.midV,255,512); }
+  else           { if(raw>k.maxV) raw=k.maxV; return map(raw,k.midV,k.maxV,512,768); }
+}
+
+// Même résultat que mapADSWithCal, pentes précalculées dans l'instantané (aucune division)
+static inline int mapJoy(int16_t raw,const CalAxis& c,const JoyCoef& k){
+  if(raw<=c.midV){ if(raw<c.minV) raw=c.minV; return 255 + (int)(((uint64_t)(raw-c.minV)*257u*k.kLo) >> 40); }
+  else           { if(raw>c.maxV) raw=c.maxV; return 512 + (int)(((uint64_t)(raw-c.midV)*256u*k.kHi) >> 40); }
+}
+
+Axes8 mapADSAll(const ADSRaw& r, const EffectiveConfig& c){
+  Axes8 a{};
+  axesForEach([&](auto ax){
+    constexpr uint8_t i = decltype(ax)::value;
+    int v = mapJoy(r.v[i], c.cal[i], c.joy[i]);
+    a.v[i] = (v < c.mapMin)? c.mapMin : (v > c.mapMax)? c.mapMax : v;
+  });
+  memcpy(a.tAcqUs, r.tAcqUs, sizeof(a.tAcqUs));
+  return a;
 }
 
 static inline uint16_t dutyToCount(float duty){
@@ -126,70 +151,77 @@ static inline uint16_t dutyToCount(float duty){
   return (uint16_t)(duty*4095.0f + 0.5f);
 }
 
-static inline void setPWMpercent(uint8_t ch,float duty){
-  if(pcaOK) pca.setPWM(ch, 0, dutyToCount(duty));
+static inline void setPWMpercent(uint8_t axis,float duty){
+  if(pcaOK) outPwm(axis, dutyToCount(duty));
 }
 
-static inline void setTOR(uint8_t ch,bool on){
-  if(!pcaOK) return;
-  if(on) pca.setPWM(ch, 4096, 0);  // full ON
-  else   pca.setPWM(ch, 0, 4096);  // full OFF
+static inline void setTOR(uint8_t axis,bool on){
+  if(pcaOK) outTor(axis, on);
 }
 
 
 
-void applyAxisToPair(uint8_t pwmCh, int val){
+void applyAxisToPair(uint8_t axis, int val, bool wired, const EffectiveConfig& c){
+  if (axis >= AX_COUNT) return;
   // Duty targets: 25% (min), 50% (neutral), 75% (max)
   const float DUTY_MIN = 0.25f;
   const float DUTY_MID = 0.50f;
-  const float DUTY_MAX = 0.75f;
+  const int mapMin = c.mapMin, mapMax = c.mapMax;
 
-  // Offset duty so neutralOffset shifts the entire PWM range.
-  float offsetDuty = -((float)neutralOffset - 512.0f) / 512.0f * (DUTY_MID - DUTY_MIN);
+  // Offset duty so neutralOffset shifts the entire PWM range (précalculé dans l'instantané).
+  float offsetDuty = c.offsetDuty;
 
   float duty = DUTY_MID + offsetDuty;
   bool active = false; // true when axis is outside neutral window
-
-  if (val < joyNeutralMin){
-    duty = mapf((float)val, (float)mapMin, (float)joyNeutralMin, DUTY_MIN, DUTY_MID) + offsetDuty;
+  // Joysticks : fenêtre de l'axe issue de la calibration ; manette : fenêtre commune.
+  // Fenêtre et pentes précalculées : pas de division ici.
+  const DutyCoef& d = c.duty[wired][axis];
+  // Courbe de l'axe : change la pente, pas la détection hors neutre (TOR)
+  int shaped = curveShape(axis, val, mapMin, d.nLo, d.nHi, mapMax);
+
+  if (val < d.nLo){
+    int x = shaped - mapMin; if(x < 0) x = 0; else if(x > d.nLo - mapMin) x = d.nLo - mapMin;
+    duty = DUTY_MIN + (float)x * d.kLo + offsetDuty;
     active = true;
-  } else if (val > joyNeutralMax){
-    duty = mapf((float)val, (float)joyNeutralMax, (float)mapMax, DUTY_MID, DUTY_MAX) + offsetDuty;
+  } else if (val > d.nHi){
+    int x = shaped - d.nHi; if(x < 0) x = 0; else if(x > mapMax - d.nHi) x = mapMax - d.nHi;
+    duty = DUTY_MID + (float)x * d.kHi + offsetDuty;
     active = true;
   }
 
   if(duty < 0) duty = 0; else if(duty > 1) duty = 1;
 
-  if (pwmCh < 8){
-    setPWMpercent(pwmCh, duty);
-    uint8_t torCh = PWM_TO_TOR[pwmCh];
-    setTOR(torCh, active);
-  }
+  setPWMpercent(axis, duty);
+  setTOR(axis, active);
+}
+// Neutralisation immédiate : les rampes sont court-circuitées et repartiront du neutre
+void neutralizeAllOutputs(){
+  rampReset();
+  axesForEach([](auto ax){ constexpr uint8_t i = decltype(ax)::value; setPWMpercent(i,0.5f); setTOR(i,false); });
+  outCommit();
 }
-void neutralizeAllOutputs(){ for(uint8_t i=0;i<8;++i) setPWMpercent(i,0.5f); for(uint8_t i=8;i<16;++i) setTOR(i,false); }
 
 static bool isAllAxesNeutral(){
-  if(!adsOK[0] || !adsOK[1] || !pcaOK) return true;
-  ADSRaw rr=readADSRaw(); Axes8 a=mapADSAll(rr);
-  auto inN=[&](int v){ return v>=joyNeutralMin && v<=joyNeutralMax; };
-  int v[8]={a.X,a.Y,a.Z,a.LX,a.LY,a.LZ,a.R1,a.R2};
-  for(int i=0;i<8;i++) if(!inN(v[i])) return false;
+  if(!ioHardwareOK()) return true;
+  const EffectiveConfig& c = effCfg();
+  ADSRaw rr=readADSRaw(); Axes8 a=mapADSAll(rr, c);
+  for(int i=0;i<AX_COUNT;i++) if(a.v[i]<c.joyNeutralMinAx[i] || a.v[i]>c.joyNeutralMaxAx[i]) return false;
   return true;
 }
 
 bool waitNeutralAtBootWithBlink(uint32_t to_ms){
-  if(!adsOK[0] || !adsOK[1] || !pcaOK) return false;
-  Serial.println("[BOOT FILAIRE] Attente du neutre");
-  uint32_t start=millis(), t0=0; bool on=false;
+  if(!ioHardwareOK()) return false;
+  LOGI(LT_BOOT, "Attente du neutre");
+  uint32_t start=halMillis(), t0=0; bool on=false;
   while(!isAllAxesNeutral()){
-    if(millis()-t0>=300){ t0=millis(); on=!on; }
+    if(halMillis()-t0>=300){ t0=halMillis(); on=!on; }
     digitalWrite(LED_VERTE_PIN,on); digitalWrite(LED_ROUGE_PIN,false);
     neutralizeAllOutputs();
-    if(to_ms && (millis()-start>to_ms)){ setFault(FC_NEUTRAL_TO,"boot_neutral"); return false; }
-    delay(20);
+    if(to_ms && (halMillis()-start>to_ms)){ setFault(FC_NEUTRAL_TO,"boot_neutral"); return false; }
+    halDelay(20);
   }
   digitalWrite(LED_VERTE_PIN,true); digitalWrite(LED_ROUGE_PIN,false);
-  Serial.println("[BOOT FILAIRE] Neutre OK."); return true;
+  LOGI(LT_BOOT, "Neutre OK."); return true;
 }
 
 // Important : calibration prioritaire
@@ -198,7 +230,7 @@ void processADS(){
   if(calibMode){
     // Sorties et GPIO27 à l’arrêt pendant calibration
     neutralizeAllOutputs();
-    digitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
+    halDigitalWrite(GPIO_MANETTE_CONNECTEE, LOW);
     return;
   }
 
@@ -206,50 +238,51 @@ void processADS(){
     return; // laisser la manette piloter les sorties
   }
 
-  if(!adsOK[0] || !adsOK[1] || !pcaOK){
+  if(!ioHardwareOK()){
     neutralizeAllOutputs();
     return;
   }
 
-  ADSRaw rr=readADSRaw(); Axes8 a=mapADSAll(rr);
+  const EffectiveConfig& c = effCfg();   // un seul instantané pour toute la trame
+  ADSRaw rr=readADSRaw(); latMarkAcquire(); Axes8 a=mapADSAll(rr, c);
+  for(uint8_t i=0;i<AX_COUNT;i++)
+    if(a.v[i]<c.joyNeutralMinAx[i] || a.v[i]>c.joyNeutralMaxAx[i]){ powerActivity(PWR_STICK, a.tAcqUs[i]); break; }
   // Inversion de l'axe Z en mode filaire
-  int invZ = neutralOffset * 2 - a.Z;
-  if(invZ < mapMin) invZ = mapMin; else if(invZ > mapMax) invZ = mapMax;
-  a.Z = invZ;
-  applyAxisToPair(0,a.X); applyAxisToPair(1,a.Y); applyAxisToPair(2,a.Z); applyAxisToPair(3,a.LX);
-  applyAxisToPair(4,a.LY); applyAxisToPair(5,a.LZ); applyAxisToPair(6,a.R1); applyAxisToPair(7,a.R2);
+  int invZ = c.neutralOffset * 2 - a.v[AX_Z];
+  if(invZ < c.mapMin) invZ = c.mapMin; else if(invZ > c.mapMax) invZ = c.mapMax;
+  a.v[AX_Z] = invZ;
+  axesForEach([&](auto ax){ constexpr uint8_t i = decltype(ax)::value; applyAxisToPair(i, rampStep(i, a.v[i], c), true, c); });
+  outCommit(); latMarkCommit();
+  for(uint8_t i=0;i<AX_COUNT;i++) latRecord(LAT_SRC_ADS, i, a.tAcqUs[i]);
 }
 
 void ioInitI2CAndPCA(){
-#if defined(ARDUINO_ARCH_ESP32)
-  Wire.begin(I2C_SDA,I2C_SCL);
-#else
-  Wire.begin();
-#endif
-  Wire.setClock(400000); delay(20);
+  halI2CBegin(); halDelay(20);
 
-  adsOK[0]=i2cExists(0x48);
-  adsOK[1]=i2cExists(0x49);
-  pcaOK   =i2cExists(0x40);
+  acqBegin();
 
-  if(adsOK[0]) { if(!ads_gnd.begin(0x48)) adsOK[0]=false; else ads_gnd.setGain(GAIN_TWOTHIRDS); }
-  if(adsOK[1]) { if(!ads_vdd.begin(0x49)) adsOK[1]=false; else ads_vdd.setGain(GAIN_TWOTHIRDS); }
-  if(pcaOK)    { pca.begin(); pca.setPWMFreq(1000); neutralizeAllOutputs(); }
+  pcaOK = true;   // étage de sortie (aucune carte à sonder en LEDC)
+  for(uint8_t b=0;b<AXES_PCA_BOARDS;b++) pcaOK = pcaOK && halI2CProbe(HAL_I2C_PCA, HAL_PCA_ADDR(b));
+  if(pcaOK){
+    pcaOK = outBegin();
+    neutralizeAllOutputs();
+  }
+  LOGI(LT_I2C, "entrées : %s, sorties : %s", acqBackendName(), outBackendName());
 }
 
 void onModeChanged(bool wiredNow){
   if (wiredNow && softRadioOverride){
     softRadioOverride = false;
-    Serial.println("[MODE] Sélecteur FILAIRE → override radio annulé.");
+    LOGI(LT_MODE, "Sélecteur FILAIRE → override radio annulé.");
   }
 
-  neutralizeAllOutputs(); modeChangeBlockUntil=millis()+MODE_CHANGE_BLOCK_MS;
+  neutralizeAllOutputs(); modeChangeBlockUntil=halMillis()+MODE_CHANGE_BLOCK_MS;
   safetyReady=false;
   stopBlink(); setLED(false,false);
   if(wiredNow){
-    wiredNeutralOK=false; digitalWrite(GPIO_MANETTE_CONNECTEE,false);
-    if(faultCode==FC_NONE){ bool ok=waitNeutralAtBootWithBlink(10000); if(ok){ wiredNeutralOK=true; digitalWrite(GPIO_MANETTE_CONNECTEE,true); } }
+    wiredNeutralOK=false; halDigitalWrite(GPIO_MANETTE_CONNECTEE,false);
+    if(faultCode==FC_NONE){ bool ok=waitNeutralAtBootWithBlink(10000); if(ok){ wiredNeutralOK=true; halDigitalWrite(GPIO_MANETTE_CONNECTEE,true); } }
   } else {
-    digitalWrite(GPIO_MANETTE_CONNECTEE, safetyReady);
+    halDigitalWrite(GPIO_MANETTE_CONNECTEE, safetyReady);
   }
 }
\ No newline at end of file
@@ -1,28 +1,30 @@
 #pragma once
 #include "Config.h"
-#include <Adafruit_ADS1X15.h>
-#include <Adafruit_PWMServoDriver.h>
+#include "Hal.h"
+#include "Axes.h"
+#include "EffConfig.h"
 
-struct CalAxis { int16_t minV, midV, maxV; };
+// Indexés par AxisIdx (Axes.h).
+// tAcqUs : horodatage halMicros() de fin de conversion, par axe (voir Latency.h)
+struct ADSRaw { int16_t v[AX_COUNT]; uint32_t tAcqUs[AX_COUNT]; };
+struct Axes8  { int     v[AX_COUNT]; uint32_t tAcqUs[AX_COUNT]; };
 
-struct AxisConfig { uint8_t adsIndex, channel; bool inverted; };
-struct ADSRaw { int16_t X,Y,Z,LX,LY,LZ,R1,R2; };
-struct Axes8  { int X,Y,Z,LX,LY,LZ,R1,R2; };
-
-extern Adafruit_ADS1115 ads_gnd, ads_vdd;
-extern Adafruit_PWMServoDriver pca;
-extern CalAxis cal[8];
-extern bool adsOK[2];
+extern CalAxis cal[AX_COUNT];
+extern bool adsOK[HAL_ADS_COUNT];
 extern bool pcaOK;
 
-extern int joyNeutralMin, joyNeutralMax;
 
 void ioInitI2CAndPCA();
 ADSRaw readADSRaw();
-Axes8  mapADSAll(const ADSRaw& r);
+const ADSRaw& adsLastRaw();   // dernier balayage (sans accès I2C)
+const ADSRaw& adsDiagRaw();   // idem ; trop ancien => relecture demandée en priorité diagnostic (portail)
+Axes8  mapADSAll(const ADSRaw& r, const EffectiveConfig& c = effCfg());
 int    mapADSWithCal(int16_t raw,const CalAxis& c);
-void   applyAxisToPair(uint8_t pwmCh,int val);
+void   applyAxisToPair(uint8_t axis,int val, bool wired, const EffectiveConfig& c = effCfg());   // sorties AXES[axis].pwm / .tor ; wired : résolu une fois par trame
 void   neutralizeAllOutputs();
+bool   ioHardwareOK();        // toutes les cartes ADS/PCA de la table AXES répondent
+void   adsNoiseReset();
+void   adsNoisePrint();       // bruit brut par axe (axes immobiles), converti en points MAP
 bool   waitNeutralAtBootWithBlink(uint32_t to_ms);
 void   processADS();
 void   onModeChanged(bool wiredNow);
@@ -0,0 +1,91 @@
+// Latency.cpp — Latence entrée → écriture PCA9685, histogrammes par source et par axe
+#include "Latency.h"
+#include "Axes.h"
+#include "Hal.h"
+#include "Log.h"
+
+struct LatHist { uint32_t n; uint64_t sumUs; uint32_t maxUs; uint32_t bucket[LAT_BUCKETS]; };
+
+static LatHist hist[LAT_SRC_COUNT][AX_COUNT];
+static const char* const SRC_NAMES[LAT_SRC_COUNT] = { "ads", "pad" };
+
+static inline uint8_t bucketOf(uint32_t us){
+  uint8_t k = 0;
+  while(us > 1 && k < LAT_BUCKETS-1){ us >>= 1; k++; }
+  return k;
+}
+
+void latRecord(LatSource src, uint8_t axis, uint32_t tAcqUs){
+  if(src>=LAT_SRC_COUNT || axis>=AX_COUNT || tAcqUs==0) return;
+  uint32_t dt = halMicros() - tAcqUs;
+  LatHist& h = hist[src][axis];
+  h.n++; h.sumUs += dt; if(dt > h.maxUs) h.maxUs = dt;
+  h.bucket[bucketOf(dt)]++;
+}
+
+void latReset(){ memset(hist, 0, sizeof(hist)); }
+
+// Borne haute du casier contenant le percentile p (en %)
+static uint32_t percentileUs(const LatHist& h, uint8_t p){
+  if(!h.n) return 0;
+  uint32_t target = (uint32_t)(((uint64_t)h.n * p + 99) / 100), acc = 0;
+  for(uint8_t k=0;k<LAT_BUCKETS;k++){
+    acc += h.bucket[k];
+    if(acc >= target) return (k == LAT_BUCKETS-1)? h.maxUs : (2u << k);
+  }
+  return h.maxUs;
+}
+
+// ---------------- Marqueur GPIO ----------------
+void latMarkerBegin(){
+#if LAT_MARKER_PIN >= 0
+  halPinOutput(LAT_MARKER_PIN); halDigitalWrite(LAT_MARKER_PIN, LOW);
+#endif
+}
+void latMarkAcquire(){
+#if LAT_MARKER_PIN >= 0
+  halDigitalWrite(LAT_MARKER_PIN, HIGH);
+#endif
+}
+void latMarkCommit(){
+#if LAT_MARKER_PIN >= 0
+  halDigitalWrite(LAT_MARKER_PIN, LOW);
+#endif
+}
+
+// ---------------- Exposition ----------------
+String latJson(){
+  String j = "{\"bucket_us\":\"2^k\",\"src\":{";
+  for(uint8_t s=0;s<LAT_SRC_COUNT;s++){
+    if(s) j += ',';
+    j += "\""; j += SRC_NAMES[s]; j += "\":[";
+    for(uint8_t a=0;a<AX_COUNT;a++){
+      const LatHist& h = hist[s][a];
+      if(a) j += ',';
+      j += "{\"axis\":\""; j += AXIS_NAMES[a]; j += "\"";
+      j += ",\"n\":" + String(h.n);
+      j += ",\"mean\":" + String(h.n ? (uint32_t)(h.sumUs / h.n) : 0u);
+      j += ",\"p50\":" + String(percentileUs(h,50));
+      j += ",\"p99\":" + String(percentileUs(h,99));
+      j += ",\"max\":" + String(h.maxUs);
+      j += ",\"hist\":[";
+      for(uint8_t k=0;k<LAT_BUCKETS;k++){ if(k) j += ','; j += String(h.bucket[k]); }
+      j += "]}";
+    }
+    j += "]";
+  }
+  j += "}}";
+  return j;
+}
+
+void latPrint(){
+  LOGI(LT_LAT, "src axe        n   moy(us)  p50(us)  p99(us)  max(us)");
+  for(uint8_t s=0;s<LAT_SRC_COUNT;s++){
+    for(uint8_t a=0;a<AX_COUNT;a++){
+      const LatHist& h = hist[s][a];
+      if(!h.n) continue;
+      LOGI(LT_LAT, "%-3s %-3s %8lu %9lu %8lu %8lu %8lu", SRC_NAMES[s], AXIS_NAMES[a], (unsigned long)h.n,
+           (unsigned long)(h.sumUs / h.n), (unsigned long)percentileUs(h,50), (unsigned long)percentileUs(h,99), (unsigned long)h.maxUs);
+    }
+  }
+}
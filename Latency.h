@@ -0,0 +1,23 @@
+// Latency.h — Latence entrée → écriture PCA9685, histogrammes par source et par axe
+#pragma once
+#include "Config.h"
+
+// Chaque échantillon est horodaté à l'acquisition (fin de conversion ADS,
+// arrivée du rapport Bluepad32). L'horodatage suit la valeur jusqu'à
+// applyAxisToPair() ; latRecord() est appelé juste après l'écriture PCA.
+
+enum LatSource : uint8_t { LAT_SRC_ADS=0, LAT_SRC_PAD, LAT_SRC_COUNT };
+
+#define LAT_BUCKETS 20   // casier k = [2^k, 2^(k+1)) µs, dernier = au-delà
+
+void latRecord(LatSource src, uint8_t axis, uint32_t tAcqUs);
+void latReset();
+
+// Sortie GPIO optionnelle pour l'oscilloscope (LAT_MARKER_PIN, Config.h) :
+// haut à l'acquisition, bas après l'écriture PCA de la trame.
+void latMarkerBegin();
+void latMarkAcquire();
+void latMarkCommit();
+
+String latJson();        // /lat.json
+void   latPrint();       // console série "lat"
@@ -0,0 +1,80 @@
+// Log.cpp — Journal série asynchrone (niveaux + tags par module)
+#include "Log.h"
+#include <atomic>
+
+static_assert((LOG_RING_SLOTS & (LOG_RING_SLOTS-1)) == 0, "LOG_RING_SLOTS doit etre une puissance de 2");
+
+struct LogSlot { uint8_t len; char text[LOG_LINE_MAX]; };
+
+static LogSlot ring[LOG_RING_SLOTS];
+static std::atomic<uint32_t> head{0};     // écrit par le producteur
+static std::atomic<uint32_t> tail{0};     // écrit par la tâche de vidage
+static std::atomic<uint32_t> dropped{0};
+static TaskHandle_t drainTask = nullptr;
+
+uint8_t logLevels[LT_COUNT];   // LOG_NONE jusqu'à logBegin()
+
+static const char* const TAG_NAMES[LT_COUNT] = {
+  "SYS","MODE","BOOT FILAIRE","I2C","PAD","CAL","MAP","BRIDAGE","DEFAUT","PORTAL","LOG","BENCH","LAT","TELEM"
+};
+
+const char* logTagName(LogTag t){ return (t<LT_COUNT)? TAG_NAMES[t] : "?"; }
+void logSetLevel(LogLevel lvl){ for(auto& l:logLevels) l=lvl; }
+void logSetTagLevel(LogTag t, LogLevel lvl){ if(t<LT_COUNT) logLevels[t]=lvl; }
+LogLevel logTagLevel(LogTag t){ return (t<LT_COUNT)? (LogLevel)logLevels[t] : LOG_NONE; }
+uint32_t logDropped(){ return dropped.load(std::memory_order_relaxed); }
+
+void logWrite(LogTag t, LogLevel lvl, const char* fmt, ...){
+  (void)lvl;
+  uint32_t h = head.load(std::memory_order_relaxed);
+  if(h - tail.load(std::memory_order_acquire) >= LOG_RING_SLOTS){
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  LogSlot& s = ring[h & (LOG_RING_SLOTS-1)];
+  int n = snprintf(s.text, LOG_LINE_MAX, "[%s] ", logTagName(t));
+  if(n < 0) n = 0;
+  va_list ap; va_start(ap, fmt);
+  int m = vsnprintf(s.text+n, LOG_LINE_MAX-n, fmt, ap);
+  va_end(ap);
+  if(m < 0) m = 0;
+  n += m;
+  if(n > LOG_LINE_MAX-2) n = LOG_LINE_MAX-2;   // message tronqué
+  s.text[n++] = '\n';
+  s.len = (uint8_t)n;
+
+  head.store(h+1, std::memory_order_release);
+}
+
+static void logDrainTask(void*){
+  uint32_t reported = 0;
+  for(;;){
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if(t == head.load(std::memory_order_acquire)){
+      uint32_t d = logDropped();
+      if(d != reported){
+        char b[48]; int n = snprintf(b, sizeof(b), "[LOG] %lu message(s) perdu(s)\n", (unsigned long)(d-reported));
+        Serial.write((const uint8_t*)b, n);
+        reported = d;
+      }
+      vTaskDelay(pdMS_TO_TICKS(5));
+      continue;
+    }
+    const LogSlot& s = ring[t & (LOG_RING_SLOTS-1)];
+    Serial.write((const uint8_t*)s.text, s.len);   // peut bloquer ici, jamais dans loop()
+    tail.store(t+1, std::memory_order_release);
+  }
+}
+
+void logFlush(uint32_t timeoutMs){
+  for(uint32_t t=0; t<timeoutMs && drainTask && tail.load(std::memory_order_acquire) != head.load(std::memory_order_relaxed); t+=5)
+    vTaskDelay(pdMS_TO_TICKS(5));
+}
+
+void logBegin(){
+  if(drainTask) return;
+  logSetLevel((LogLevel)LOG_LEVEL_DEFAULT);
+  // Cœur 0, priorité minimale au-dessus de l'idle : la tâche Arduino (cœur 1) n'attend jamais l'UART
+  xTaskCreatePinnedToCore(logDrainTask, "log", 3072, nullptr, tskIDLE_PRIORITY+1, &drainTask, 0);
+}
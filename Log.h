@@ -0,0 +1,39 @@
+// Log.h — Journal série asynchrone (niveaux + tags par module)
+#pragma once
+#include "Config.h"
+
+// Les messages sont formatés dans un anneau sans verrou par la tâche Arduino
+// (producteur unique) puis vidés vers l'UART par une tâche basse priorité.
+// Un message qui ne trouve pas de place est compté comme perdu : le chemin de
+// contrôle ne bloque jamais sur le port série.
+
+enum LogLevel : uint8_t { LOG_NONE=0, LOG_ERROR, LOG_WARN, LOG_INFO, LOG_DEBUG };
+
+enum LogTag : uint8_t {
+  LT_SYS=0, LT_MODE, LT_BOOT, LT_I2C, LT_PAD, LT_CAL, LT_MAP,
+  LT_BRIDAGE, LT_DEFAUT, LT_PORTAL, LT_LOG, LT_BENCH, LT_LAT, LT_TELEM, LT_COUNT
+};
+
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS 32   // puissance de 2 (cible hôte : 1024, aucun message perdu au banc)
+#endif
+#define LOG_LINE_MAX   112  // préfixe + message + '\n'
+
+void logBegin();                                  // démarre la tâche de vidage
+void logSetLevel(LogLevel lvl);                   // tous les tags
+void logSetTagLevel(LogTag t, LogLevel lvl);
+LogLevel logTagLevel(LogTag t);
+const char* logTagName(LogTag t);
+uint32_t logDropped();                            // messages perdus (anneau plein)
+void logFlush(uint32_t timeoutMs);                // attend le vidage de l'anneau (fin de programme hôte)
+
+extern uint8_t logLevels[LT_COUNT];
+inline bool logEnabled(LogTag t, LogLevel lvl){ return lvl <= logLevels[t]; }
+
+void logWrite(LogTag t, LogLevel lvl, const char* fmt, ...) __attribute__((format(printf,3,4)));
+
+#define LOG_AT(t,l,...) do{ if((l)<=LOG_LEVEL_MAX && logEnabled((t),(l))) logWrite((t),(l),__VA_ARGS__); }while(0)
+#define LOGE(t,...) LOG_AT(t,LOG_ERROR,__VA_ARGS__)
+#define LOGW(t,...) LOG_AT(t,LOG_WARN,__VA_ARGS__)
+#define LOGI(t,...) LOG_AT(t,LOG_INFO,__VA_ARGS__)
+#define LOGD(t,...) LOG_AT(t,LOG_DEBUG,__VA_ARGS__)
@@ -0,0 +1,56 @@
+// Output.cpp — Étage de sortie par axe (proportionnel + TOR) : PCA9685 ou LEDC/GPIO
+#include "Output.h"
+#include "Hal.h"
+#include "I2cSched.h"
+
+#if OUTPUT_BACKEND == OUTPUT_PCA9685
+// ---------------- PCA9685 : voies AXES[].pwm / .tor ----------------
+bool outBegin(){
+  bool ok = true;
+  for(uint8_t b=0;b<AXES_PCA_BOARDS;b++) ok = halPcaBegin(b, HAL_PCA_ADDR(b), 1000) && ok;
+  return ok;
+}
+void outPwm(uint8_t axis, uint16_t count){ halPcaSet(AXES[axis].pwm, 0, count); }
+void outTor(uint8_t axis, bool on){
+  if(on) halPcaSet(AXES[axis].tor, OUT_PWM_FULL, 0);  // full ON
+  else   halPcaSet(AXES[axis].tor, 0, OUT_PWM_FULL);  // full OFF
+}
+void outCommit(){ i2cBegin(I2C_COMMIT); halPcaFlush(); i2cEnd(); }
+uint16_t outPwmState(uint8_t axis){ return halPcaDuty(AXES[axis].pwm); }
+bool outTorState(uint8_t axis){ return halPcaDuty(AXES[axis].tor) == OUT_PWM_FULL; }
+const char* outBackendName(){ return "PCA9685"; }
+
+#elif OUTPUT_BACKEND == OUTPUT_LEDC
+// ---------------- LEDC (proportionnel) + GPIO (TOR) ----------------
+// Valeurs fantômes comme pour le PCA : seules les voies modifiées sont écrites au commit.
+static uint16_t pwm[AX_COUNT];
+static bool tor[AX_COUNT];
+static uint16_t dirty = 0xFFFF;   // bit i = pwm axe i, bit 8+i = tor axe i ; tout au premier commit
+static_assert(AX_COUNT <= 8, "Output LEDC : masque dirty sur 16 bits");
+
+bool outBegin(){
+  bool ok = true;
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    if(OUT_PWM_PIN[i] >= 0) ok = halLedcBegin(OUT_PWM_PIN[i], OUT_LEDC_FREQ_HZ, 12) && ok;
+    if(OUT_TOR_PIN[i] >= 0){ halPinOutput(OUT_TOR_PIN[i]); halDigitalWrite(OUT_TOR_PIN[i], false); }
+  }
+  dirty = 0xFFFF;
+  return ok;
+}
+void outPwm(uint8_t axis, uint16_t count){ if(pwm[axis]!=count){ pwm[axis]=count; dirty |= 1u<<axis; } }
+void outTor(uint8_t axis, bool on){ if(tor[axis]!=on){ tor[axis]=on; dirty |= 1u<<(AX_COUNT+axis); } }
+void outCommit(){
+  if(!dirty) return;
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    if((dirty & (1u<<i)) && OUT_PWM_PIN[i] >= 0) halLedcWrite(OUT_PWM_PIN[i], pwm[i]);
+    if((dirty & (1u<<(AX_COUNT+i))) && OUT_TOR_PIN[i] >= 0) halDigitalWrite(OUT_TOR_PIN[i], tor[i]);
+  }
+  dirty = 0;
+}
+uint16_t outPwmState(uint8_t axis){ return pwm[axis]; }
+bool outTorState(uint8_t axis){ return tor[axis]; }
+const char* outBackendName(){ return "LEDC"; }
+
+#else
+#error "OUTPUT_BACKEND : OUTPUT_PCA9685 ou OUTPUT_LEDC"
+#endif
@@ -0,0 +1,20 @@
+// Output.h — Étage de sortie par axe (proportionnel + TOR) : PCA9685 ou LEDC/GPIO
+#pragma once
+#include "Config.h"
+#include "Axes.h"
+
+// applyAxisToPair() / neutralizeAllOutputs() n'écrivent que par ici.
+// Les écritures sont mises en attente puis envoyées ensemble par outCommit() :
+//   - OUTPUT_PCA9685 : une rafale I2C par carte (halPcaFlush)
+//   - OUTPUT_LEDC    : registres LEDC + GPIO, aucun trafic bus ; broche -1 ignorée
+// Choix à la compilation : OUTPUT_BACKEND (Config.h).
+
+#define OUT_PWM_FULL 4096   // pas de rapport cyclique (12 bits) ; 4096 = plein ON
+
+bool     outBegin();                             // cartes PCA (déjà sondées) ou broches LEDC/GPIO
+void     outPwm(uint8_t axis, uint16_t count);   // 0..4095
+void     outTor(uint8_t axis, bool on);
+void     outCommit();
+uint16_t outPwmState(uint8_t axis);              // dernière valeur demandée (télémétrie)
+bool     outTorState(uint8_t axis);
+const char* outBackendName();
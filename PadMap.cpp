@@ -0,0 +1,46 @@
+// PadMap.cpp — Moteur unique manette → axes (coefficients précalculés dans EffConfig)
+#include "PadMap.h"
+
+uint32_t padMapVersion(){ return effCfg().version; }
+
+static inline int clampAxis(int32_t v, const PadAxisCoef& c){
+  // même ordre que constrain(v, lo, hi), y compris si lo > hi
+  return (v < c.lo)? c.lo : (v > c.hi)? c.hi : v;
+}
+
+// map(x, -512, 512, lo, hi) : (x+512)*span/1024 + lo (division entière identique)
+static inline int stick(int32_t x, const PadAxisCoef& c){ return clampAxis((x + 512) * c.span / 1024 + c.lo, c); }
+
+// map(t, 0, 1023, n, lo|hi)
+static inline int trigger(int32_t t, int32_t d, const PadAxisCoef& c){ return clampAxis(t * d / 1023 + c.n, c); }
+
+void padMapCompute(const PadSample& s, bool lxInverted, PadFrame& out){
+  const EffectiveConfig& cfg = effCfg();
+  const PadAxisCoef* coef = cfg.pad;
+  out.ver = cfg.version;
+  int32_t lx = lxInverted? -(int32_t)s.lx : s.lx;
+
+  out.v[AX_X]  = stick(s.rx, coef[AX_X]);
+  out.v[AX_Y]  = stick(s.ry, coef[AX_Y]);
+  out.v[AX_LX] = stick(lx,   coef[AX_LX]);
+  out.v[AX_LY] = stick(s.ly, coef[AX_LY]);
+
+  const PadAxisCoef& z = coef[AX_Z];
+  if(s.throttle > 0)   out.v[AX_Z] = trigger(s.throttle, z.dNeg, z);
+  else if(s.brake > 0) out.v[AX_Z] = trigger(s.brake,    z.dPos, z);
+  else                 out.v[AX_Z] = z.n;
+
+  const PadAxisCoef& lz = coef[AX_LZ];
+  out.v[AX_LZ] = (s.dpad == PAD_DPAD_UP)? lz.hi : (s.dpad == PAD_DPAD_DOWN)? lz.lo : lz.n;
+
+  const PadAxisCoef& r1 = coef[AX_R1];
+  const PadAxisCoef& r2 = coef[AX_R2];
+  out.v[AX_R1] = (s.buttons & 0x0001)? r1.lo : (s.buttons & 0x0002)? r1.hi : r1.n;
+  out.v[AX_R2] = (s.buttons & 0x0004)? r2.lo : (s.buttons & 0x0008)? r2.hi : r2.n;
+}
+
+bool padMapNeutral(const PadFrame& f){
+  const PadAxisCoef* coef = effCfg().pad;
+  for(int i=0;i<AX_COUNT;i++) if(f.v[i] < coef[i].nLo || f.v[i] > coef[i].nHi) return false;
+  return true;
+}
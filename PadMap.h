@@ -0,0 +1,17 @@
+// PadMap.h — Moteur unique manette → axes (coefficients précalculés dans EffConfig)
+#pragma once
+#include "Config.h"
+#include "Hal.h"
+#include "Bridage.h"
+#include "EffConfig.h"
+
+// Une trame par rapport Bluepad32, partagée par processControllers()
+// (sorties), controllerAxesNeutral() (armement) et /pad (portail).
+// Les coefficients par axe (effCfg().pad) sont reconstruits par effCfgRebuild()
+// quand le bridage ou neutralOffset changent. ver = version de l'instantané utilisé.
+// Résultat identique, au bit près, à l'ancien map()+constrain().
+struct PadFrame { int v[AX_COUNT]; uint32_t tUs; uint32_t ver; };
+
+uint32_t padMapVersion();                // version de l'instantané publié
+void padMapCompute(const PadSample& s, bool lxInverted, PadFrame& out);
+bool padMapNeutral(const PadFrame& f);   // tous les axes dans leur fenêtre d'armement (nLo..nHi)
@@ -1,9 +1,13 @@
 #include "Portal.h"
 #include <WiFi.h>
+#include "Log.h"
+#include "Latency.h"
+#include "CmdQueue.h"
+#include "Trace.h"
 
 static WebServer server(80);
 static DNSServer dns;
-static bool active = false;
+static bool active = false, staKept = false;
 static IPAddress apIP(192,168,4,1), apGW(192,168,4,1), apMask(255,255,255,0);
 
 WebServer& portalServer(){ return server; }
@@ -22,14 +26,33 @@ static String homePage(){
     "<a href='/defaut'>D\u00E9faut ESP32</a>"
     "<a href='/calib'>Calibration</a>"
     "<a href='/bridage'>Bridage axes</a>"
+    "<a href='/lat.json'>Latences (JSON)</a>"
+    "<a href='/trace.json'>Trace (Perfetto)</a>"
     "</body></html>"
   );
 }
 
+const char* portalAckJs(){
+  return
+    "function ackWait(r){ if(!r.ok) throw new Error('busy'); return r.text().then(function(id){ return new Promise(function(ok,ko){ var n=0;"
+    " (function poll(){ fetch('/ack?id='+id,{cache:'no-store'}).then(function(x){return x.json();}).then(function(a){"
+    " if(a.state==='done') ok(a); else if(a.state==='unknown' || ++n>40) ko(a); else setTimeout(poll,25); }).catch(ko); })(); }); }); }";
+}
+
+static void sendAck(){
+  uint32_t id = (uint32_t)server.arg("id").toInt();
+  CmdAck a = cmdAckStatus(id);
+  String j = "{\"id\":"; j += String((unsigned long)id);
+  j += ",\"state\":\""; j += (a==ACK_DONE)? "done" : (a==ACK_PENDING)? "pending" : "unknown"; j += "\"}";
+  server.send(200,"application/json",j);
+}
+
 void portalStart(const char* ssid){
   if (active) return;
 
-  WiFi.mode(WIFI_AP);
+  // Garder la station de la télémétrie (Telemetry.cpp) si elle est active
+  staKept = (WiFi.getMode() == WIFI_STA || WiFi.getMode() == WIFI_AP_STA);
+  WiFi.mode(staKept? WIFI_AP_STA : WIFI_AP);
   WiFi.softAPConfig(apIP, apGW, apMask);
   WiFi.softAP(ssid);
 
@@ -43,10 +66,13 @@ void portalStart(const char* ssid){
   server.on("/connecttest.txt", HTTP_GET, [](){ server.sendHeader("Location","/",true); server.send(302,"text/plain",""); });
 
   server.on("/", HTTP_GET, [](){ server.send(200,"text/html",homePage()); });
+  server.on("/lat.json", HTTP_GET, [](){ server.send(200,"application/json",latJson()); });
+  server.on("/ack", HTTP_GET, sendAck);
+  traceRegisterRoutes();
 
   server.begin();
   active = true;
-  Serial.println("[PORTAL] AP unique actif : SSID=ESP32-CONTROLE");
+  LOGI(LT_PORTAL, "AP unique actif : SSID=ESP32-CONTROLE");
 }
 
 void portalStop(){
@@ -55,13 +81,15 @@ void portalStop(){
   dns.stop();
   WiFi.softAPdisconnect(true);
   // Ne pas couper le Bluetooth en arrêtant uniquement le Wi-Fi
-  WiFi.mode(WIFI_MODE_NULL);
+  WiFi.mode(staKept? WIFI_STA : WIFI_MODE_NULL);
   active = false;
-  Serial.println("[PORTAL] AP stoppé.");
+  LOGI(LT_PORTAL, "AP stoppé.");
 }
 
 void portalHandle(){
   if (!active) return;
   dns.processNextRequest();
+  uint32_t t0 = halMicros();
   server.handleClient();
+  if(halMicros() - t0 >= TRACE_HTTP_MIN_US) traceHttp(t0, server.uri().c_str());   // requête servie
 }
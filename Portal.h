@@ -15,3 +15,7 @@ bool portalActive();
 void portalStart(const char* ssid = "ESP32-CONTROLE");  // idempotent
 void portalStop();                                      // coupe AP + serveurs
 void portalHandle();                                    // à appeler souvent
+
+// JS commun : ackWait(réponse) attend que la commande postée (202 + n°, CmdQueue.h)
+// soit appliquée par la boucle, via /ack?id=N. Promesse rejetée si 503 ou délai.
+const char* portalAckJs();
@@ -0,0 +1,97 @@
+// Power.cpp — Repos basse consommation : tick lent et CPU ralenti quand rien ne bouge
+#include "Power.h"
+#include "Hal.h"
+#include "Calibration.h"
+#include "Controllers.h"
+#include "IOMap.h"
+#include "Bridage.h"
+#include "Portal.h"
+#include "Log.h"
+
+static const uint32_t FAST_TICK_MS = 5;
+static const char* const SRC_NAMES[PWR_SOURCES] = { "manette", "stick", "entrée", "système" };
+
+static bool idle = false;
+static uint32_t lastActivityMs = 0, stateSinceMs = 0;
+static bool wakePending = false;
+static uint32_t wakeEvtUs = 0;
+static int lastSel = -1, lastBtn = -1;
+
+// Résidence par régime et latence de réveil (observation → fin du premier tick rapide)
+struct PowerStats { uint32_t entries, wakes[PWR_SOURCES], n, mn, mx; uint64_t sum, activeMs, idleMs; };
+static PowerStats st;
+
+static void account(uint32_t now){ (idle? st.idleMs : st.activeMs) += now - stateSinceMs; stateSinceMs = now; }
+
+void powerBegin(){
+  lastActivityMs = stateSinceMs = halMillis();
+  lastSel = halDigitalRead(MODE_SEL_PIN); lastBtn = halDigitalRead(CAL_BTN_PIN);
+}
+
+void powerActivity(PowerSrc src, uint32_t tEventUs){
+  lastActivityMs = halMillis();
+  if(!idle) return;
+  account(lastActivityMs);
+  idle = false;
+  halPowerIdle(false);
+  st.wakes[src]++;
+  wakeEvtUs = tEventUs; wakePending = true;
+  LOGI(LT_SYS, "repos -> actif (%s)", SRC_NAMES[src]);
+}
+
+void powerPoll(){
+  int sel = halDigitalRead(MODE_SEL_PIN), btn = halDigitalRead(CAL_BTN_PIN);
+  if(sel == lastSel && btn == lastBtn) return;
+  lastSel = sel; lastBtn = btn;
+  powerActivity(PWR_INPUT, halMicros());
+}
+
+static bool mustStayActive(){
+  if(calibMode || portalActive() || isBridageActive()) return true;
+  return !isEffectiveWiredMode() && safetyReady;
+}
+
+void powerUpdate(){
+  if(wakePending){
+    wakePending = false;
+    uint32_t lat = halMicros() - wakeEvtUs;
+    if(!st.n || lat<st.mn) st.mn=lat;
+    if(!st.n || lat>st.mx) st.mx=lat;
+    st.n++; st.sum += lat;
+  }
+#if POWER_IDLE_ENABLE
+  uint32_t now = halMillis();
+  if(mustStayActive()){
+    if(idle) powerActivity(PWR_SYSTEM, halMicros()); else lastActivityMs = now;
+    return;
+  }
+  if(idle || now - lastActivityMs < POWER_IDLE_AFTER_MS) return;
+  account(now);
+  idle = true; st.entries++;
+  halPowerIdle(true);
+  LOGI(LT_SYS, "actif -> repos : tick %u ms, CPU %u MHz", (unsigned)powerTickMs(), (unsigned)POWER_IDLE_CPU_MHZ);
+#endif
+}
+
+bool powerIdle(){ return idle; }
+// Filaire : les sticks ne sont vus qu'au scan, le tick reste rapide (seul le CPU ralentit)
+uint32_t powerTickMs(){ return (idle && !isEffectiveWiredMode())? POWER_IDLE_TICK_MS : FAST_TICK_MS; }
+uint32_t powerPollMs(){ return idle? FAST_TICK_MS : 1; }
+
+void powerStatsReset(){ st = {}; stateSinceMs = halMillis(); }
+
+void powerStatsPrint(){
+  account(halMillis());
+  uint64_t tot = st.activeMs + st.idleMs;
+  uint32_t idlePm = tot? (uint32_t)(st.idleMs * 1000 / tot) : 0;
+  LOGI(LT_SYS, "power : %s, repos %lu.%lu %% sur %lu s, %lu entrée(s) au repos", idle? "REPOS" : "actif",
+       (unsigned long)(idlePm/10), (unsigned long)(idlePm%10), (unsigned long)(tot/1000), (unsigned long)st.entries);
+  LOGI(LT_SYS, "réveils : %s %lu, %s %lu, %s %lu, %s %lu", SRC_NAMES[0], (unsigned long)st.wakes[0],
+       SRC_NAMES[1], (unsigned long)st.wakes[1], SRC_NAMES[2], (unsigned long)st.wakes[2], SRC_NAMES[3], (unsigned long)st.wakes[3]);
+  if(st.n) LOGI(LT_SYS, "latence de réveil : min=%lu moy=%lu max=%lu us",
+                (unsigned long)st.mn, (unsigned long)(st.sum / st.n), (unsigned long)st.mx);
+  // Estimation, pas une mesure : résidence x courant nominal ; mA x ms / 3600 = µAh
+  uint64_t mAms = st.activeMs * POWER_ACTIVE_MA + st.idleMs * POWER_IDLE_MA;
+  LOGI(LT_SYS, "énergie ESTIMÉE (non mesurée) : %lu uAh, moyenne %lu mA (nominal %u actif / %u repos)",
+       (unsigned long)(mAms / 3600), (unsigned long)(tot? mAms / tot : 0), (unsigned)POWER_ACTIVE_MA, (unsigned)POWER_IDLE_MA);
+}
@@ -0,0 +1,26 @@
+// Power.h — Repos basse consommation : tick lent et CPU ralenti quand rien ne bouge
+#pragma once
+#include "Config.h"
+
+// Régime rapide : tick de 5 ms. Passage au repos en fin de tour (powerUpdate) si,
+// depuis POWER_IDLE_AFTER_MS, aucune activité n'a été signalée et que :
+//   - mode manette : système désarmé (jamais au repos armé) ;
+//   - mode filaire : sticks restés dans leur fenêtre neutre (processADS) ;
+//   - ni calibration, ni portail, ni bridage en cours.
+// Au repos : halPowerIdle(true) (CPU ralenti) ; en mode manette, tick de
+// POWER_IDLE_TICK_MS. L'attente de fin de tick (controllersWaitEvents) sonde
+// manette, sélecteur et bouton toutes les 5 ms : la moindre activité rétablit le
+// tick rapide et la fréquence CPU au plus tard au tick rapide suivant. En mode
+// filaire le tick reste rapide : un stick n'est vu qu'au scan, qui garde son rythme.
+
+enum PowerSrc : uint8_t { PWR_PAD=0, PWR_STICK, PWR_INPUT, PWR_SYSTEM, PWR_SOURCES };
+
+void     powerBegin();
+void     powerActivity(PowerSrc src, uint32_t tEventUs);   // tEventUs : instant où l'activité a été observée
+void     powerPoll();        // attente de fin de tick : sélecteur et bouton calibration
+void     powerUpdate();      // fin de tour : maintien / passage au repos, latence de réveil
+bool     powerIdle();
+uint32_t powerTickMs();      // durée du tick courant
+uint32_t powerPollMs();      // pas de sondage pendant l'attente
+void     powerStatsReset();
+void     powerStatsPrint();  // console série "power" : résidence, réveils, énergie estimée (non mesurée)
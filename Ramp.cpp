@@ -0,0 +1,47 @@
+// Ramp.cpp — Limiteur de pente par axe (virgule fixe Q8)
+#include "Ramp.h"
+#include "Hal.h"
+#include "IOMap.h"
+
+#define RAMP_FULL_SPAN  256      // neutre (512) → butée (768) en points d'axe
+#define RAMP_MAX_DT_US  50000u   // un tick plus long n'autorise pas un saut plus grand
+
+uint16_t rampAccelMs[AX_COUNT];
+uint16_t rampDecelMs[AX_COUNT];
+
+static int32_t  posQ8[AX_COUNT];   // position courante, 1/256 de point
+static uint32_t lastUs[AX_COUNT];
+static bool     live[AX_COUNT];    // false = repartir du neutre au prochain pas
+
+void rampSetDefaults(){
+  for(int i=0;i<AX_COUNT;i++){ rampAccelMs[i]=RAMP_ACCEL_MS_DEFAULT; rampDecelMs[i]=RAMP_DECEL_MS_DEFAULT; }
+}
+
+void rampReset(){ for(auto& l:live) l=false; }
+
+static inline int32_t stepQ8(uint16_t ms, uint32_t dtUs){
+  return (int32_t)(((uint64_t)(RAMP_FULL_SPAN<<8) * dtUs) / ((uint32_t)ms * 1000u));
+}
+
+int rampStep(uint8_t i, int target, const EffectiveConfig& c){
+  if(i>=AX_COUNT) return target;
+  uint32_t now = halMicros();
+  int32_t n = c.neutralOffset << 8;   // neutre vu par l'étage de sortie (centre de la fenêtre commune)
+  int32_t t = (int32_t)target << 8;
+  if(!live[i]){ posQ8[i]=n; lastUs[i]=now; live[i]=true; }
+  uint32_t dt = now - lastUs[i]; lastUs[i] = now;
+  if(dt > RAMP_MAX_DT_US) dt = RAMP_MAX_DT_US;
+
+  int32_t p = posQ8[i];
+  if(p == t) return target;
+  bool away = (p == n) || ((t > p) == (p > n));
+  uint16_t ms = away? rampAccelMs[i] : rampDecelMs[i];
+  if(!ms){ posQ8[i] = t; return target; }
+
+  // En décélération, on s'arrête au neutre avant de repartir de l'autre côté (en accel)
+  int32_t s = stepQ8(ms, dt);
+  if(t > p){ int32_t lim = (!away && t > n)? n : t; p = (p + s < lim)? p + s : lim; }
+  else     { int32_t lim = (!away && t < n)? n : t; p = (p - s > lim)? p - s : lim; }
+  posQ8[i] = p;
+  return (p + 128) >> 8;
+}
@@ -0,0 +1,15 @@
+// Ramp.h — Limiteur de pente par axe (virgule fixe Q8) entre valeur d'axe et applyAxisToPair()
+#pragma once
+#include "Config.h"
+#include "Bridage.h"
+#include "EffConfig.h"
+
+// Temps en ms pour parcourir neutre → pleine course (accel, on s'éloigne du neutre)
+// et pleine course → neutre (decel, on y revient). 0 = instantané.
+// Réglés depuis /bridage et sauvegardés avec le bridage (EEPROM).
+extern uint16_t rampAccelMs[AX_COUNT];
+extern uint16_t rampDecelMs[AX_COUNT];
+
+int  rampStep(uint8_t axis, int target, const EffectiveConfig& c = effCfg());  // valeur à appliquer ce tick (pas calculé sur halMicros())
+void rampReset();                         // les rampes repartent du neutre (neutralizeAllOutputs)
+void rampSetDefaults();
@@ -0,0 +1,130 @@
+// Telemetry.cpp — Temps de boucle + télémétrie binaire UDP vers un collecteur local
+#include "Telemetry.h"
+#include "Hal.h"
+#include "IOMap.h"
+#include "Controllers.h"
+#include "Portal.h"
+#include "Output.h"
+#include "Trace.h"
+#include "Log.h"
+#include <WiFi.h>
+#include <WiFiUdp.h>
+
+// ======================== Temps de boucle ========================
+struct LoopStat { uint32_t n; uint64_t sum; uint32_t mn, mx; };
+static LoopStat statPeriod, statBusy;
+static uint32_t tickStartUs = 0, lastStartUs = 0;
+static uint32_t winPeriodMax = 0, winBusyMax = 0;   // fenêtre de l'échantillon en cours
+
+static inline void statAdd(LoopStat& s, uint32_t v){
+  if(!s.n || v<s.mn) s.mn=v;
+  if(!s.n || v>s.mx) s.mx=v;
+  s.n++; s.sum += v;
+}
+
+void loopStatsReset(){ statPeriod = {}; statBusy = {}; lastStartUs = 0; }
+
+static void printStat(const char* name, const LoopStat& s){
+  if(!s.n){ LOGI(LT_SYS, "%-7s : aucune mesure", name); return; }
+  LOGI(LT_SYS, "%-7s : n=%lu min=%lu moy=%lu max=%lu us", name, (unsigned long)s.n,
+       (unsigned long)s.mn, (unsigned long)(s.sum / s.n), (unsigned long)s.mx);
+}
+
+void loopStatsPrint(){
+  printStat("periode", statPeriod);
+  printStat("travail", statBusy);
+}
+
+// ======================== Télémétrie UDP ========================
+#if TELEMETRY_ENABLE
+static WiFiUDP udp;
+static IPAddress hostIP;
+static bool hostSet = false;
+static struct __attribute__((packed)) { TelemHeader h; TelemSample s[TELEMETRY_BATCH]; } pkt;
+static uint8_t pktCount = 0, tickDiv = 0;
+static uint32_t seq = 0, lost = 0;
+
+static_assert(TELEMETRY_EVERY >= 1 && TELEMETRY_BATCH >= 1 && TELEMETRY_BATCH <= 24,
+              "TELEMETRY_BATCH : 1..24 (paquet < MTU)");
+
+static inline uint16_t sat16(uint32_t v){ return v>0xFFFF? 0xFFFF : (uint16_t)v; }
+
+static void sample(TelemSample& s){
+  s.tUs = halMicros();
+  const ADSRaw& r = adsLastRaw();
+  int pad[AX_COUNT];
+  bool padValid = getPadValues(pad);
+  s.tor = 0;
+  for(uint8_t i=0;i<AX_COUNT;i++){
+    s.ads[i] = r.v[i];
+    s.pad[i] = (int16_t)pad[i];
+    s.pca[i] = outPwmState(i);
+    if(outTorState(i)) s.tor |= (1u<<i);
+  }
+  s.mode  = calibMode? TM_CALIB : isEffectiveWiredMode()? TM_FILAIRE : TM_MANETTE;
+  s.flags = (safetyReady? TF_SAFETY_READY : 0) | (padValid? TF_PAD_VALID : 0)
+          | (softRadioOverride? TF_SOFT_RADIO : 0) | (pcaOK? TF_PCA_OK : 0);
+  s.fault = faultCode;
+  s.loopUs = sat16(winPeriodMax);
+  s.busyUs = sat16(winBusyMax);
+}
+
+// Liaison : station connectée, sinon AP du portail ; destination fixe ou diffusion
+static bool destination(IPAddress& ip){
+  bool sta = (WiFi.status() == WL_CONNECTED);
+  if(!sta && !portalActive()) return false;
+  ip = hostSet? hostIP : sta? WiFi.broadcastIP() : WiFi.softAPBroadcastIP();
+  return true;
+}
+
+static void sendBatch(){
+  pkt.h = { TELEM_MAGIC, TELEM_VERSION, pktCount, (uint16_t)sizeof(TelemSample), seq, lost };
+  IPAddress ip;
+  if(destination(ip) && udp.beginPacket(ip, TELEMETRY_PORT)){
+    udp.write((const uint8_t*)&pkt, sizeof(TelemHeader) + pktCount*sizeof(TelemSample));
+    if(!udp.endPacket()) lost += pktCount;
+  } else {
+    lost += pktCount;
+  }
+  seq += pktCount;
+  pktCount = 0;
+}
+#endif
+
+void telemetryBegin(){
+#if TELEMETRY_ENABLE
+  hostSet = (TELEMETRY_HOST[0] != 0) && hostIP.fromString(TELEMETRY_HOST);
+  if(TELEMETRY_STA_SSID[0]){
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(TELEMETRY_STA_SSID, TELEMETRY_STA_PASS);
+    LOGI(LT_TELEM, "station Wi-Fi : %s", TELEMETRY_STA_SSID);
+  }
+  LOGI(LT_TELEM, "UDP :%d, %u o/échantillon, %d échantillons/paquet, 1 tour sur %d",
+       TELEMETRY_PORT, (unsigned)sizeof(TelemSample), TELEMETRY_BATCH, TELEMETRY_EVERY);
+#endif
+}
+
+void loopTickBegin(){
+  uint32_t now = halMicros();
+  if(lastStartUs){
+    uint32_t p = now - lastStartUs;
+    statAdd(statPeriod, p);
+    if(p > winPeriodMax) winPeriodMax = p;
+  }
+  lastStartUs = tickStartUs = now;
+}
+
+void loopTickEnd(){
+  uint32_t busy = halMicros() - tickStartUs;
+  traceSpan(TR_TICK, tickStartUs);
+  statAdd(statBusy, busy);
+  if(busy > winBusyMax) winBusyMax = busy;
+
+#if TELEMETRY_ENABLE
+  if(++tickDiv < TELEMETRY_EVERY) return;
+  tickDiv = 0;
+  sample(pkt.s[pktCount++]);
+  winPeriodMax = winBusyMax = 0;
+  if(pktCount >= TELEMETRY_BATCH) sendBatch();
+#endif
+}
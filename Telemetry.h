@@ -0,0 +1,49 @@
+// Telemetry.h — Temps de boucle + télémétrie binaire UDP vers un collecteur local
+#pragma once
+#include "Config.h"
+#include "Axes.h"
+
+// Trame (petit-boutiste, sans remplissage) : un en-tête puis `count` échantillons.
+// Toute modification de TelemSample ou TelemHeader => TELEM_VERSION++ et
+// mise à jour de tools/telemetry_rx.py (même ordre de champs).
+#define TELEM_MAGIC   0x54475650u   // "PVGT"
+#define TELEM_VERSION 1
+
+struct __attribute__((packed)) TelemHeader {
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  count;        // échantillons dans le paquet
+  uint16_t sampleSize;   // sizeof(TelemSample)
+  uint32_t seq;          // n° du premier échantillon (continu : un trou = paquet perdu)
+  uint32_t lost;         // échantillons jetés faute de liaison depuis le démarrage
+};
+
+// Modes (champ mode)
+enum TelemMode : uint8_t { TM_MANETTE=0, TM_FILAIRE, TM_CALIB };
+// Drapeaux (champ flags)
+#define TF_SAFETY_READY 0x01
+#define TF_PAD_VALID    0x02
+#define TF_SOFT_RADIO   0x04
+#define TF_PCA_OK       0x08
+
+struct __attribute__((packed)) TelemSample {
+  uint32_t tUs;               // halMicros()
+  int16_t  ads[AX_COUNT];     // dernier balayage ADS brut (figé hors mode filaire)
+  int16_t  pad[AX_COUNT];     // trame manette (MAP), 0 sans manette
+  uint16_t pca[AX_COUNT];     // sortie PWM AXES[i].pwm, pas 0..4096
+  uint8_t  tor;               // bit i = TOR AXES[i].tor actif
+  uint8_t  mode;              // TelemMode
+  uint8_t  flags;             // TF_*
+  uint8_t  fault;             // faultCode
+  uint16_t loopUs;            // période de loop() max depuis l'échantillon précédent (saturée)
+  uint16_t busyUs;            // travail max d'un tour (hors attente de fin de tick)
+};
+static_assert(sizeof(TelemHeader) == 16, "TelemHeader : format figé");
+static_assert(sizeof(TelemSample) == 60, "TelemSample : format figé");
+
+void telemetryBegin();        // station Wi-Fi si TELEMETRY_STA_SSID (setup)
+void loopTickBegin();         // début de loop()
+void loopTickEnd();           // avant l'attente de fin de tick : stats + échantillon/envoi
+
+void loopStatsReset();
+void loopStatsPrint();        // console série "loop"
@@ -0,0 +1,90 @@
+// Trace.cpp — Trace d'événements (intervalles) exportée au format Chrome trace-event
+#include "Trace.h"
+#include "Portal.h"
+#include <atomic>
+
+#if TRACE_ENABLE
+static_assert((TRACE_EVENTS & (TRACE_EVENTS-1)) == 0, "TRACE_EVENTS : puissance de 2");
+
+static const char* const TRACE_NAMES[TR_COUNT] = {
+  "tick", "cmd", "manette", "filaire", "bridage", "portail", "service", "attente",
+  "i2c commit", "i2c scan", "i2c diag", "rafale pca", "http", "eeprom commit"
+};
+static const char* const TRACE_CATS[TR_COUNT] = {
+  "loop", "loop", "loop", "loop", "loop", "loop", "loop", "loop",
+  "i2c", "i2c", "i2c", "i2c", "http", "flash"
+};
+
+struct TraceEvt { uint32_t t0, dur; TraceId id; uint8_t tid; uint16_t arg; };
+static TraceEvt ring[TRACE_EVENTS];
+static std::atomic<uint32_t> head{0};
+static std::atomic<bool> frozen{false};
+
+#define TRACE_URIS 8
+static char uris[TRACE_URIS][24];
+static uint8_t nUris = 0;
+
+void traceSpan(TraceId id, uint32_t t0Us, uint16_t arg){
+  if(frozen.load(std::memory_order_relaxed)) return;
+  uint32_t now = halMicros();
+  uint32_t h = head.fetch_add(1, std::memory_order_relaxed);
+  ring[h & (TRACE_EVENTS-1)] = { t0Us, now - t0Us, id, (uint8_t)(id==TR_PCA_TX? 2 : 1), arg };
+}
+
+// Table d'URI tenue par la tâche Arduino seule ; pleine => dernière entrée partagée
+void traceHttp(uint32_t t0Us, const char* uri){
+  uint8_t k = 0;
+  while(k<nUris && strncmp(uris[k], uri, sizeof(uris[0])-1)) k++;
+  if(k==nUris){
+    if(nUris < TRACE_URIS){ snprintf(uris[nUris], sizeof(uris[0]), "%s", uri); nUris++; }
+    else k = TRACE_URIS-1;
+  }
+  traceSpan(TR_HTTP, t0Us, k);
+}
+
+void traceReset(){ head.store(0, std::memory_order_relaxed); }
+
+uint32_t traceExport(void (*emit)(const char*, size_t)){
+  frozen.store(true, std::memory_order_relaxed);
+  uint32_t h = head.load(std::memory_order_acquire);
+  uint32_t first = (h > TRACE_EVENTS)? h - TRACE_EVENTS : 0;
+  // Un parent est écrit après ses enfants : base = plus petit t0 de la fenêtre,
+  // cherché en écart signé (rebouclage de halMicros() toléré)
+  uint32_t base = (h > first)? ring[first & (TRACE_EVENTS-1)].t0 : 0;
+  int32_t lo = 0;
+  for(uint32_t k=first;k<h;k++){ int32_t d = (int32_t)(ring[k & (TRACE_EVENTS-1)].t0 - base); if(d < lo) lo = d; }
+  base += (uint32_t)lo;
+  char buf[1024]; size_t n = 0;
+  n += snprintf(buf+n, sizeof(buf)-n, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"loop\"}},"
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"pcaTx\"}}");
+  for(uint32_t k=first;k<h;k++){
+    const TraceEvt& e = ring[k & (TRACE_EVENTS-1)];
+    if(e.id >= TR_COUNT) continue;
+    if(n > sizeof(buf)-160){ emit(buf, n); n = 0; }
+    n += snprintf(buf+n, sizeof(buf)-n, ",{\"name\":\"%s%s%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":%u}",
+                  TRACE_NAMES[e.id], e.id==TR_HTTP? " " : "", e.id==TR_HTTP && e.arg<nUris? uris[e.arg] : "",
+                  TRACE_CATS[e.id], (unsigned long)(e.t0 - base), (unsigned long)e.dur, (unsigned)e.tid);
+  }
+  n += snprintf(buf+n, sizeof(buf)-n, "]}");
+  emit(buf, n);
+  frozen.store(false, std::memory_order_relaxed);
+  return h - first;
+}
+#else
+uint32_t traceExport(void (*emit)(const char*, size_t)){ emit("{\"traceEvents\":[]}", 18); return 0; }
+void traceReset(){}
+#endif
+
+static void emitHttp(const char* b, size_t n){ portalServer().sendContent(b, n); }
+
+void traceRegisterRoutes(){
+  WebServer& server = portalServer();
+  server.on("/trace.json", HTTP_GET, [&](){
+    server.sendHeader("Content-Disposition", "attachment; filename=trace.json");
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+    traceExport(emitHttp);
+    server.sendContent("");
+  });
+}
@@ -0,0 +1,37 @@
+// Trace.h — Trace d'événements (intervalles) exportée au format Chrome trace-event
+#pragma once
+#include "Config.h"
+#include "Hal.h"
+
+// Un intervalle = un enregistrement écrit à la fin (début + durée, phase "X") :
+// pas de début orphelin quand l'anneau déborde, imbrication libre.
+// Écriture sans verrou (index atomique) : tâche Arduino et tâche d'envoi PCA (Wire1).
+// L'export gèle l'anneau le temps de l'envoi ; la vue montre les TRACE_EVENTS derniers.
+
+enum TraceId : uint8_t {
+  TR_TICK=0, TR_CMD, TR_PAD, TR_ADS, TR_BRIDAGE, TR_PORTAL, TR_SERVICE, TR_WAIT,
+  TR_I2C_COMMIT, TR_I2C_SAMPLE, TR_I2C_DIAG, TR_PCA_TX, TR_HTTP, TR_FLASH, TR_COUNT
+};
+
+#if TRACE_ENABLE
+void traceSpan(TraceId id, uint32_t t0Us, uint16_t arg = 0);   // [t0Us .. maintenant]
+void traceHttp(uint32_t t0Us, const char* uri);                // nom = URI (table de 8)
+
+struct TraceScope {
+  uint32_t t0; TraceId id;
+  explicit TraceScope(TraceId i) : t0(halMicros()), id(i) {}
+  ~TraceScope(){ traceSpan(id, t0); }
+};
+#define TRACE_CAT2(a,b) a##b
+#define TRACE_CAT(a,b)  TRACE_CAT2(a,b)
+#define TRACE_SCOPE(id) TraceScope TRACE_CAT(traceScope_, __LINE__)(id)
+#else
+inline void traceSpan(TraceId, uint32_t, uint16_t = 0){}
+inline void traceHttp(uint32_t, const char*){}
+#define TRACE_SCOPE(id) ((void)0)
+#endif
+
+// JSON {"traceEvents":[...]} par morceaux (< 1 Ko) ; renvoie le nombre d'événements
+uint32_t traceExport(void (*emit)(const char* buf, size_t len));
+void traceRegisterRoutes();     // /trace.json sur le portail (envoi en flux)
+void traceReset();
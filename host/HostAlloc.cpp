@@ -0,0 +1,28 @@
+// HostAlloc.cpp — Compteur d'allocations de l'hôte (colonne "alloc" du banc)
+// malloc/calloc/realloc et operator new passent par ici avant l'allocateur de la glibc.
+// Compte par fil : la tâche de journal n'entre pas dans les mesures du banc.
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void  __libc_free(void*);
+
+static thread_local uint32_t allocs = 0;
+uint32_t hostAllocCount(){ return allocs; }
+
+extern "C" void* malloc(size_t n){ allocs++; return __libc_malloc(n); }
+extern "C" void* calloc(size_t k, size_t n){ allocs++; return __libc_calloc(k, n); }
+extern "C" void* realloc(void* p, size_t n){ allocs++; return __libc_realloc(p, n); }
+extern "C" void  free(void* p){ __libc_free(p); }
+
+void* operator new(size_t n){ void* p = malloc(n? n : 1); if(!p) throw std::bad_alloc(); return p; }
+void* operator new[](size_t n){ return operator new(n); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept { return malloc(n? n : 1); }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { return malloc(n? n : 1); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
@@ -0,0 +1,55 @@
+// HostArduino.cpp — Implémentation hôte du cœur Arduino / FreeRTOS (voir include/)
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <WiFi.h>
+#include "Hal.h"
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+WiFiClass WiFi;
+
+// Horloge et GPIO : ceux de la HAL simulée (horloge virtuelle)
+unsigned long millis(){ return halMillis(); }
+unsigned long micros(){ return halMicros(); }
+void delay(uint32_t ms){ halDelay(ms); }
+int  digitalRead(uint8_t pin){ return halDigitalRead(pin); }
+void digitalWrite(uint8_t pin, uint8_t val){ halDigitalWrite(pin, val != LOW); }
+void pinMode(uint8_t, uint8_t){}
+
+// Comme WMath.cpp du cœur ESP32 : division entière tronquée, -1 si plage d'entrée nulle
+long map(long x, long in_min, long in_max, long out_min, long out_max){
+  const long run = in_max - in_min;
+  if(run == 0) return -1;
+  return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+static const uint32_t HOST_CPU_MHZ = 240;
+uint32_t getCpuFrequencyMhz(){ return HOST_CPU_MHZ; }
+bool setCpuFrequencyMhz(uint32_t){ return true; }
+
+// Cycles d'un ESP32 à 240 MHz sur l'horloge monotone de l'hôte (mesures du banc)
+uint32_t EspClass::getCycleCount(){
+  using namespace std::chrono;
+  uint64_t ns = (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  return (uint32_t)(ns * HOST_CPU_MHZ / 1000ULL);
+}
+
+size_t HardwareSerial::printf(const char* fmt, ...){
+  va_list ap; va_start(ap, fmt);
+  int n = vprintf(fmt, ap);
+  va_end(ap);
+  fflush(stdout);
+  return n < 0? 0 : (size_t)n;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char*, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t){
+  std::thread(fn, arg).detach();
+  if(handle) *handle = (TaskHandle_t)fn;
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks){ std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
@@ -0,0 +1,125 @@
+// Arduino.h — Cœur Arduino minimal pour la cible hôte (HAL_SIM=1 sous Linux)
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+#include "freertos/FreeRTOS.h"
+
+// Seul ce que le croquis utilise en dehors de HalEsp32.cpp : horloge et GPIO
+// renvoient vers la HAL simulée, Serial écrit sur stdout, ESP compte des cycles
+// à 240 MHz sur l'horloge monotone de l'hôte.
+
+using std::min; using std::max;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+#define F(s) (s)
+#define IRAM_ATTR
+#define PROGMEM
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+int  digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+void pinMode(uint8_t pin, uint8_t mode);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+uint32_t getCpuFrequencyMhz();
+bool setCpuFrequencyMhz(uint32_t mhz);
+
+// ---------------- String (sur std::string) ----------------
+class String {
+public:
+  String(const char* s = "") : s_(s? s : "") {}
+  String(const std::string& s) : s_(s) {}
+  explicit String(char c) : s_(1, c) {}
+  String(unsigned char v) : s_(std::to_string(v)) {}
+  String(int v) : s_(std::to_string(v)) {}
+  String(unsigned v) : s_(std::to_string(v)) {}
+  String(long v) : s_(std::to_string(v)) {}
+  String(unsigned long v) : s_(std::to_string(v)) {}
+  String(float v, unsigned dec = 2) : String((double)v, dec) {}
+  String(double v, unsigned dec = 2) { char b[40]; snprintf(b, sizeof(b), "%.*f", (int)dec, v); s_ = b; }
+
+  unsigned length() const { return (unsigned)s_.size(); }
+  const char* c_str() const { return s_.c_str(); }
+  void reserve(unsigned n) { s_.reserve(n); }
+  char operator[](unsigned i) const { return i < s_.size()? s_[i] : 0; }
+  long toInt() const { return atol(s_.c_str()); }
+  float toFloat() const { return (float)atof(s_.c_str()); }
+  int indexOf(char c, unsigned from = 0) const { size_t p = s_.find(c, from); return p == std::string::npos? -1 : (int)p; }
+  int indexOf(const String& t, unsigned from = 0) const { size_t p = s_.find(t.s_, from); return p == std::string::npos? -1 : (int)p; }
+  String substring(unsigned from) const { return from < s_.size()? String(s_.substr(from)) : String(); }
+  String substring(unsigned from, unsigned to) const {
+    if(from > to) std::swap(from, to);
+    if(from >= s_.size()) return String();
+    return String(s_.substr(from, std::min<size_t>(to, s_.size()) - from));
+  }
+  void replace(const String& a, const String& b) {
+    if(a.s_.empty()) return;
+    for(size_t p = s_.find(a.s_); p != std::string::npos; p = s_.find(a.s_, p + b.s_.size())) s_.replace(p, a.s_.size(), b.s_);
+  }
+  void replace(char a, char b) { std::replace(s_.begin(), s_.end(), a, b); }
+  void trim() {
+    size_t a = s_.find_first_not_of(" \t\r\n"), b = s_.find_last_not_of(" \t\r\n");
+    s_ = (a == std::string::npos)? std::string() : s_.substr(a, b - a + 1);
+  }
+  bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* o) { s_ += o? o : ""; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  String& operator+=(int v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(unsigned v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(long v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(unsigned long v) { s_ += std::to_string(v); return *this; }
+  template<class T> String& concat(const T& v) { return *this += v; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String& a, const char* b) { return String(a.s_ + (b? b : "")); }
+  friend String operator+(const char* a, const String& b) { return String((a? a : "") + b.s_); }
+  friend String operator+(const String& a, char c) { return String(a.s_ + c); }
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* o) const { return s_ == (o? o : ""); }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+  bool operator!=(const char* o) const { return !(*this == o); }
+
+private:
+  std::string s_;
+};
+
+// ---------------- Serial (stdout ; pas d'entrée console sur l'hôte) ----------------
+class HardwareSerial {
+public:
+  void begin(unsigned long) {}
+  int  available() { return 0; }
+  int  read() { return -1; }
+  void flush() { fflush(stdout); }
+  size_t write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+  size_t write(const uint8_t* b, size_t n) { size_t r = fwrite(b, 1, n, stdout); fflush(stdout); return r; }
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const String& s) { return print(s.c_str()); }
+  size_t println(const char* s = "") { return print(s) + print("\n"); }
+  size_t println(const String& s) { return println(s.c_str()); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf,2,3)));
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  uint32_t getCycleCount();
+  uint32_t getFreeHeap() { return 0; }
+};
+extern EspClass ESP;
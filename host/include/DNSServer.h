@@ -0,0 +1,19 @@
+// DNSServer.h — Serveur DNS inerte (portail captif sans réseau sur l'hôte)
+#pragma once
+#include <Arduino.h>
+
+class IPAddress {
+public:
+  IPAddress(int a = 0, int b = 0, int c = 0, int d = 0) : b_{(uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d} {}
+  bool fromString(const char* s) { unsigned a, b, c, d; if(!s || sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d) != 4) return false; *this = IPAddress(a, b, c, d); return true; }
+  uint8_t operator[](int i) const { return b_[i & 3]; }
+private:
+  uint8_t b_[4];
+};
+
+class DNSServer {
+public:
+  bool start(uint16_t, const char*, const IPAddress&) { return true; }
+  void stop() {}
+  void processNextRequest() {}
+};
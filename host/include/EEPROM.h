@@ -0,0 +1,18 @@
+// EEPROM.h — EEPROM émulée en mémoire (effacée à 0xFF à chaque lancement)
+#pragma once
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+  bool begin(size_t size) { return size <= sizeof(mem_); }
+  bool commit() { return true; }
+  uint8_t read(int a) { return inRange(a, 1)? mem_[a] : 0; }
+  void write(int a, uint8_t v) { if(inRange(a, 1)) mem_[a] = v; }
+  template<class T> T& get(int a, T& t) { if(inRange(a, sizeof(T))) memcpy((void*)&t, mem_ + a, sizeof(T)); return t; }
+  template<class T> const T& put(int a, const T& t) { if(inRange(a, sizeof(T))) memcpy(mem_ + a, (const void*)&t, sizeof(T)); return t; }
+  EEPROMClass() { memset(mem_, 0xFF, sizeof(mem_)); }
+private:
+  bool inRange(int a, size_t n) const { return a >= 0 && (size_t)a + n <= sizeof(mem_); }
+  uint8_t mem_[4096];
+};
+extern EEPROMClass EEPROM;
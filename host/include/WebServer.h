@@ -0,0 +1,26 @@
+// WebServer.h — Serveur HTTP inerte : routes enregistrées, aucune requête reçue
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+public:
+  explicit WebServer(int = 80) {}
+  void on(const char*, std::function<void()>) {}
+  void on(const char*, HTTPMethod, std::function<void()>) {}
+  void begin() {}
+  void stop() {}
+  void handleClient() {}
+  void send(int, const char* = nullptr, const String& = String()) {}
+  void send(int, const char*, const char*) {}
+  void sendHeader(const String&, const String&, bool = false) {}
+  void setContentLength(size_t) {}
+  void sendContent(const String&) {}
+  void sendContent(const char*, size_t) {}
+  bool hasArg(const String&) { return false; }
+  String arg(const String&) { return String(); }
+  String uri() { return String("/"); }
+};
@@ -0,0 +1,24 @@
+// WiFi.h — WiFi de l'hôte : le point d'accès « démarre », la station « se connecte »
+// dès qu'un SSID est donné (trafic UDP en boucle locale, WiFiUdp.h)
+#pragma once
+#include <DNSServer.h>
+
+typedef enum { WIFI_MODE_NULL = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 };
+
+class WiFiClass {
+public:
+  void mode(int m) { mode_ = m; }
+  int  getMode() { return mode_; }
+  bool softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+  bool softAP(const char*, const char* = nullptr) { return true; }
+  bool softAPdisconnect(bool = false) { return true; }
+  int  begin(const char* ssid, const char* = nullptr) { status_ = (ssid && *ssid)? WL_CONNECTED : WL_DISCONNECTED; return status_; }
+  int  status() { return status_; }
+  IPAddress broadcastIP() { return IPAddress(255, 255, 255, 255); }
+  IPAddress softAPBroadcastIP() { return IPAddress(192, 168, 4, 255); }
+private:
+  int mode_ = WIFI_MODE_NULL;
+  int status_ = WL_DISCONNECTED;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,34 @@
+// WiFiUdp.h — UDP de l'hôte : chaque paquet part réellement vers 127.0.0.1 (même port),
+// quelle que soit l'adresse demandée (diffusion, AP du portail, collecteur fixe)
+#pragma once
+#include <WiFi.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+
+class WiFiUDP {
+public:
+  ~WiFiUDP() { stop(); }
+  uint8_t begin(uint16_t) { return open(); }
+  int  beginPacket(IPAddress, uint16_t port) { if(!open()) return 0; port_ = port; len_ = 0; return 1; }
+  size_t write(const uint8_t* b, size_t n) {
+    if(n > sizeof(buf_) - len_) n = sizeof(buf_) - len_;
+    memcpy(buf_ + len_, b, n); len_ += n; return n;
+  }
+  int  endPacket() {
+    sockaddr_in to = {};
+    to.sin_family = AF_INET; to.sin_port = htons(port_); to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ssize_t r = ::sendto(fd_, buf_, len_, 0, (const sockaddr*)&to, sizeof(to));
+    len_ = 0;
+    return r >= 0;
+  }
+  void stop() { if(fd_ >= 0) ::close(fd_); fd_ = -1; }
+private:
+  uint8_t open() { if(fd_ < 0) fd_ = ::socket(AF_INET, SOCK_DGRAM, 0); return fd_ >= 0; }
+  int fd_ = -1;
+  uint16_t port_ = 0;
+  size_t len_ = 0;
+  uint8_t buf_[1472];   // charge utile UDP max sous MTU Ethernet
+};
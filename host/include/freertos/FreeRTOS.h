@@ -0,0 +1,21 @@
+// FreeRTOS.h — Ce que le croquis utilise de FreeRTOS, sur threads de l'hôte
+#pragma once
+#include <stdint.h>
+
+typedef void*    TaskHandle_t;
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdPASS   1
+#define pdTRUE   1
+#define pdFALSE  0
+#define portMAX_DELAY 0xffffffffu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskIDLE_PRIORITY 0
+
+// Tâche = thread détaché (le cœur est ignoré) ; vTaskDelay dort en temps réel
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t prio, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelay(TickType_t ticks);
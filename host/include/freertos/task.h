@@ -0,0 +1,3 @@
+// task.h — voir FreeRTOS.h
+#pragma once
+#include "FreeRTOS.h"
@@ -0,0 +1,17 @@
+// main.cpp — Cible hôte : le croquis complet (setup() puis loop()) contre HalSim
+#include "../ESP32_PVG32_Controller.ino"
+
+// pvg32_host [tours] : setup() puis N tours de loop() en temps virtuel (défaut 2000).
+// Code de sortie : 0 si tout s'est bien passé, sinon le nombre d'échecs du banc
+// (BENCH_ENABLE) ou 1 si un défaut est actif à la fin.
+int main(int argc, char** argv){
+  long loops = (argc > 1)? atol(argv[1]) : 2000;
+  setup();
+  for(long i=0; i<loops; i++) loop();
+  logFlush(2000);
+  fflush(stdout);
+#if BENCH_ENABLE
+  if(benchFailures()) return (int)std::min<uint32_t>(benchFailures(), 125);
+#endif
+  return (faultCode != FC_NONE)? 1 : 0;
+}
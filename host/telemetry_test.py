@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+# telemetry_test.py — ctest host_telemetry_udp : pvg32_sim (TELEMETRY_ENABLE=1) émet en UDP
+# sur 127.0.0.1, tools/telemetry_rx.py décode ; on vérifie le CSV obtenu.
+#
+#   telemetry_test.py <pvg32_sim_telem> <telemetry_rx.py> <port> <échantillons>
+
+import csv
+import io
+import subprocess
+import sys
+import time
+
+
+def fail(msg):
+    print("ÉCHEC " + msg, file=sys.stderr)
+    sys.exit(1)
+
+
+def main():
+    sim, rx, port, count = sys.argv[1], sys.argv[2], sys.argv[3], int(sys.argv[4])
+    recv = subprocess.Popen([sys.executable, rx, "--bind", "127.0.0.1", "--port", port, "--count", str(count)],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    time.sleep(0.5)   # collecteur à l'écoute avant le premier paquet
+    run = subprocess.run([sim, "4000"], stdout=subprocess.DEVNULL, timeout=60)
+    try:
+        out, err = recv.communicate(timeout=10)
+    except subprocess.TimeoutExpired:
+        recv.kill()
+        out, err = recv.communicate()
+        fail("collecteur : moins de %d échantillons reçus (%s)" % (count, err.strip()))
+    if run.returncode != 0:
+        fail("pvg32_sim : code de sortie %d" % run.returncode)
+
+    rows = list(csv.DictReader(io.StringIO(out)))
+    print(err.strip())
+    if len(rows) < count or " 0 trou(s)" not in err:
+        fail("%d échantillon(s) décodé(s) sur %d, %s" % (len(rows), count, err.strip()))
+    for k, r in enumerate(rows):
+        if int(r["seq"]) != k:
+            fail("seq %s en position %d (continuité)" % (r["seq"], k))
+        if k and int(r["t_us"]) <= int(rows[k - 1]["t_us"]):
+            fail("t_us non croissant en seq %d" % k)
+        # Démarrage filaire, sticks simulés au neutre : sorties à 50 %, TOR relâchés, aucun défaut
+        if r["mode"] != "filaire" or r["lost"] != "0" or r["fault"] != "0" or r["pca_ok"] != "1":
+            fail("seq %d : mode %s, perdus %s, défaut %s, pca_ok %s" % (k, r["mode"], r["lost"], r["fault"], r["pca_ok"]))
+        for a in ("X", "Y", "Z", "LX", "LY", "LZ", "R1", "R2"):
+            if abs(int(r["ads_" + a]) - 16384) > 1 or abs(int(r["pca_" + a]) - 2048) > 1 or r["tor_" + a] != "0":
+                fail("seq %d axe %s : ads %s, pca %s, tor %s" % (k, a, r["ads_" + a], r["pca_" + a], r["tor_" + a]))
+        if int(r["loop_us"]) == 0:
+            fail("seq %d : loop_us nul" % k)
+    print("télémétrie UDP : %d échantillons continus, valeurs conformes" % len(rows))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+# telemetry_rx.py — Collecteur UDP de la télémétrie ESP32 PVG32 -> CSV
+#
+# Format : Telemetry.h (TELEM_VERSION 1). Garder les structures ci-dessous
+# alignées champ à champ sur TelemHeader / TelemSample.
+#
+#   python3 tools/telemetry_rx.py                  # port 4210, CSV sur stdout
+#   python3 tools/telemetry_rx.py -o run.csv       # vers un fichier
+#   python3 tools/telemetry_rx.py --port 5000 --count 1000
+
+import argparse
+import socket
+import struct
+import sys
+
+MAGIC = 0x54475650  # "PVGT"
+VERSION = 1
+AXES = ["X", "Y", "Z", "LX", "LY", "LZ", "R1", "R2"]
+MODES = {0: "manette", 1: "filaire", 2: "calib"}
+
+HEADER = struct.Struct("<IBBHII")          # magic, version, count, sampleSize, seq, lost
+SAMPLE = struct.Struct("<I8h8h8HBBBBHH")   # tUs, ads[8], pad[8], pca[8], tor, mode, flags, fault, loopUs, busyUs
+assert HEADER.size == 16 and SAMPLE.size == 60
+
+COLUMNS = (["seq", "t_us"]
+           + [f"ads_{a}" for a in AXES]
+           + [f"pad_{a}" for a in AXES]
+           + [f"pca_{a}" for a in AXES]
+           + [f"tor_{a}" for a in AXES]
+           + ["mode", "safety_ready", "pad_valid", "soft_radio", "pca_ok", "fault",
+              "loop_us", "busy_us", "lost"])
+
+
+def decode(data):
+    """Retourne (seq, lost, [lignes]) ou lève ValueError si le paquet est invalide."""
+    if len(data) < HEADER.size:
+        raise ValueError("paquet trop court")
+    magic, version, count, size, seq, lost = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("magic inconnu 0x%08X" % magic)
+    if version != VERSION or size != SAMPLE.size:
+        raise ValueError("version %d / échantillon %d o non gérés" % (version, size))
+    if len(data) < HEADER.size + count * size:
+        raise ValueError("paquet tronqué")
+    rows = []
+    for k in range(count):
+        f = SAMPLE.unpack_from(data, HEADER.size + k * size)
+        t_us, ads, pad, pca = f[0], f[1:9], f[9:17], f[17:25]
+        tor, mode, flags, fault, loop_us, busy_us = f[25:31]
+        rows.append([seq + k, t_us, *ads, *pad, *pca,
+                     *[(tor >> i) & 1 for i in range(8)],
+                     MODES.get(mode, mode),
+                     flags & 1, (flags >> 1) & 1, (flags >> 2) & 1, (flags >> 3) & 1,
+                     fault, loop_us, busy_us, lost])
+    return seq, lost, rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Télémétrie UDP ESP32 PVG32 -> CSV")
+    ap.add_argument("--port", type=int, default=4210)
+    ap.add_argument("--bind", default="0.0.0.0")
+    ap.add_argument("-o", "--output", help="fichier CSV (défaut : stdout)")
+    ap.add_argument("--count", type=int, default=0, help="arrêt après N échantillons (0 = sans fin)")
+    args = ap.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_BROADCAST, 1)
+    sock.bind((args.bind, args.port))
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    out.write(",".join(COLUMNS) + "\n")
+    expected, total, gaps = None, 0, 0
+    try:
+        while not args.count or total < args.count:
+            data, src = sock.recvfrom(2048)
+            try:
+                seq, lost, rows = decode(data)
+            except ValueError as e:
+                print("%s : %s" % (src[0], e), file=sys.stderr)
+                continue
+            if expected is not None and seq != expected:
+                gaps += 1
+                print("trou : %d échantillon(s) manquant(s) avant seq %d" % (seq - expected, seq), file=sys.stderr)
+            expected = seq + len(rows)
+            for r in rows:
+                out.write(",".join(str(v) for v in r) + "\n")
+            total += len(rows)
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        print("%d échantillons, %d trou(s) réseau" % (total, gaps), file=sys.stderr)
+        if out is not sys.stdout:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()